@@ -0,0 +1,66 @@
+#include "bench_common.hpp"
+#include <ics_combinable_vector.hpp>
+
+#include <mutex>
+#include <thread>
+
+// Usage: bench_combinableVector [items] [threads]
+// Worker threads each produce items that end up in one Vector: appended
+// under a shared mutex, collected per thread and concatenated serially,
+// and collected in a CombinableVector and combined in parallel.
+namespace {
+    template <typename F>
+    void run_threads(size_t threads, F&& work) {
+        Vector<std::thread> pool;
+        for (size_t t = 0; t < threads; ++t) pool.push_back(std::thread(work, t));
+        for (std::thread& thread : pool) thread.join();
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, size_t{16} << 20);
+    size_t threads = arg_size(argc, argv, 2, 8);
+    size_t per_thread = n / threads;
+
+    Vector<int64_t> shared;
+    std::mutex mutex;
+    double mutex_ms = time_ms([&] {
+        run_threads(threads, [&](size_t t) {
+            for (size_t i = 0; i < per_thread; ++i) {
+                std::lock_guard<std::mutex> lock(mutex);
+                shared.push_back(static_cast<int64_t>(t * per_thread + i));
+            }
+        });
+    });
+
+    Vector<Vector<int64_t>> parts;
+    for (size_t t = 0; t < threads; ++t) parts.push_back(Vector<int64_t>());
+    Vector<int64_t> serial;
+    double serial_ms = time_ms([&] {
+        run_threads(threads, [&](size_t t) {
+            for (size_t i = 0; i < per_thread; ++i) parts[t].push_back(static_cast<int64_t>(t * per_thread + i));
+        });
+        for (const Vector<int64_t>& part : parts) {
+            for (int64_t value : part) serial.push_back(value);
+        }
+    });
+
+    CombinableVector<int64_t> combinable;
+    Vector<int64_t> combined;
+    double combine_ms = 0;
+    double combinable_ms = time_ms([&] {
+        run_threads(threads, [&](size_t t) {
+            Vector<int64_t>& local = combinable.local();
+            for (size_t i = 0; i < per_thread; ++i) local.push_back(static_cast<int64_t>(t * per_thread + i));
+        });
+        combine_ms = time_ms([&] { combined = combinable.combine(); });
+    });
+
+    if (shared.size() != combined.size() || serial.size() != combined.size()) return 1;
+    std::printf("%zu items from %zu threads\n", per_thread * threads, threads);
+    std::printf("%-24s %12s\n", "", "total ms");
+    std::printf("%-24s %12.1f\n", "shared Vector + mutex", mutex_ms);
+    std::printf("%-24s %12.1f\n", "per-thread + serial", serial_ms);
+    std::printf("%-24s %12.1f  (combine %.1f)\n", "CombinableVector", combinable_ms, combine_ms);
+    return 0;
+}
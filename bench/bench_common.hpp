@@ -0,0 +1,32 @@
+#ifndef ICS_BENCH_COMMON_HPP
+#define ICS_BENCH_COMMON_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+
+// Wall-clock time of one call to f, in milliseconds.
+template <typename F>
+double time_ms(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// Keeps the compiler from discarding a computed result.
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Problem size from argv[index], or fallback when absent.
+inline size_t arg_size(int argc, char** argv, int index, size_t fallback) {
+    if (argc > index) {
+        return static_cast<size_t>(std::strtoull(argv[index], nullptr, 10));
+    }
+    return fallback;
+}
+
+#endif
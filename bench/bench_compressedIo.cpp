@@ -0,0 +1,59 @@
+#include "bench_common.hpp"
+#include <ics_compressed_io.hpp>
+
+#include <random>
+#include <string>
+#include <sys/stat.h>
+
+// Usage: bench_compressedIo [elements] [threads] [path]
+// Compares save_binary/load_binary with save_compressed/load_compressed on
+// timestamp-like integers and a random walk of prices.
+namespace {
+    template <typename T>
+    void compare(const char* label, const Vector<T>& values, ThreadPool& pool, const std::string& path) {
+        double mib = values.size() * sizeof(T) / 1048576.0;
+        struct stat info;
+
+        double plain_write = time_ms([&] { save_binary(values, path); });
+        double plain_read = time_ms([&] { do_not_optimize(load_binary<T>(path).size()); });
+
+        CompressionOptions options;
+        options.pool = &pool;
+        double packed_write = time_ms([&] { save_compressed(values, path, options); });
+        ::stat(path.c_str(), &info);
+        Vector<T> loaded;
+        double packed_read = time_ms([&] { loaded = load_compressed<T>(path, &pool); });
+
+        std::printf("%-10s %8.1f %8.2fx %12.0f %12.0f %12.0f %12.0f%s\n", label, mib,
+                    mib * 1048576.0 / static_cast<double>(info.st_size), mib / plain_write * 1000,
+                    mib / plain_read * 1000, mib / packed_write * 1000, mib / packed_read * 1000,
+                    loaded == values ? "" : "  MISMATCH");
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, size_t{16} << 20);
+    size_t threads = arg_size(argc, argv, 2, 0);
+    ThreadPool pool(threads);
+    std::string path = argc > 3 ? argv[3] : "/tmp/ics_bench_compressed_io.bin";
+    std::mt19937_64 rng(17);
+
+    Vector<int64_t> stamps(n);
+    Vector<double> prices(n);
+    int64_t stamp = 1700000000000;
+    double price = 100.0;
+    for (size_t i = 0; i < n; ++i) {
+        stamp += static_cast<int64_t>(rng() % 2000);
+        stamps.push_back(stamp);
+        price += static_cast<double>(static_cast<int>(rng() % 21) - 10) / 100.0;
+        prices.push_back(price);
+    }
+
+    std::printf("%zu elements, %zu-thread pool\n", n, pool.size());
+    std::printf("%-10s %8s %9s %12s %12s %12s %12s\n", "", "MiB", "ratio", "plain w MB/s", "plain r MB/s",
+                "lz w MB/s", "lz r MB/s");
+    compare("int64_t", stamps, pool, path);
+    compare("double", prices, pool, path);
+    ::unlink(path.c_str());
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "bench_common.hpp"
+#include <ics_concurrent_vector.hpp>
+
+#include <mutex>
+#include <thread>
+
+// Usage: bench_concurrentVector [appends] [max threads]
+// Threads append a fixed total of values into one shared container: a
+// Vector behind a mutex, and a ConcurrentVector. Thread counts double from
+// one up to the maximum.
+namespace {
+    template <typename F>
+    double run_threads(size_t threads, F&& work) {
+        return time_ms([&] {
+            Vector<std::thread> pool;
+            for (size_t t = 0; t < threads; ++t) pool.push_back(std::thread(work, t));
+            for (std::thread& thread : pool) thread.join();
+        });
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, size_t{8} << 20);
+    size_t max_threads = arg_size(argc, argv, 2, 32);
+
+    std::printf("%zu appends in total, %u hardware threads\n", n, std::thread::hardware_concurrency());
+    std::printf("%8s %14s %14s %10s\n", "threads", "mutex ms", "concurrent ms", "speedup");
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        size_t per_thread = n / threads;
+
+        Vector<int64_t> locked;
+        std::mutex mutex;
+        double mutex_ms = run_threads(threads, [&](size_t t) {
+            for (size_t i = 0; i < per_thread; ++i) {
+                std::lock_guard<std::mutex> lock(mutex);
+                locked.push_back(static_cast<int64_t>(t * per_thread + i));
+            }
+        });
+
+        ConcurrentVector<int64_t> concurrent;
+        double concurrent_ms = run_threads(threads, [&](size_t t) {
+            for (size_t i = 0; i < per_thread; ++i) {
+                concurrent.push_back(static_cast<int64_t>(t * per_thread + i));
+            }
+        });
+
+        if (locked.size() != concurrent.size()) return 1;
+        std::printf("%8zu %14.1f %14.1f %9.2fx\n", threads, mutex_ms, concurrent_ms, mutex_ms / concurrent_ms);
+    }
+    return 0;
+}
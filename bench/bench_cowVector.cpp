@@ -0,0 +1,45 @@
+#include "bench_common.hpp"
+#include <ics_cow_vector.hpp>
+
+#include <random>
+
+// Usage: bench_cowVector [elements] [snapshots] [writes per snapshot]
+// A writer takes a snapshot, then updates a few random elements, over and
+// over: once deep-copying a Vector per snapshot, once with CowVector.
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, size_t{4} << 20);
+    size_t snapshots = arg_size(argc, argv, 2, 200);
+    size_t writes = arg_size(argc, argv, 3, 100);
+
+    Vector<int64_t> plain;
+    CowVector<int64_t> cow;
+    for (size_t i = 0; i < n; ++i) {
+        plain.push_back(static_cast<int64_t>(i));
+        cow.push_back(static_cast<int64_t>(i));
+    }
+
+    std::mt19937_64 rng(29);
+    double copy_ms = time_ms([&] {
+        for (size_t s = 0; s < snapshots; ++s) {
+            Vector<int64_t> snapshot = plain;
+            for (size_t w = 0; w < writes; ++w) plain[rng() % n] += 1;
+            do_not_optimize(snapshot[0]);
+        }
+    });
+
+    rng.seed(29);
+    double cow_ms = time_ms([&] {
+        for (size_t s = 0; s < snapshots; ++s) {
+            CowSnapshot<int64_t> snapshot = cow.snapshot();
+            for (size_t w = 0; w < writes; ++w) cow[rng() % n] += 1;
+            do_not_optimize(snapshot[0]);
+        }
+    });
+
+    bool same = cow == plain;
+    std::printf("%zu elements, %zu snapshots, %zu writes each\n", n, snapshots, writes);
+    std::printf("%-16s %12s %14s\n", "", "total ms", "per snapshot");
+    std::printf("%-16s %12.1f %14.3f\n", "Vector copy", copy_ms, copy_ms / snapshots);
+    std::printf("%-16s %12.1f %14.3f\n", "CowVector", cow_ms, cow_ms / snapshots);
+    return same ? 0 : 1;
+}
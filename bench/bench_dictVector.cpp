@@ -0,0 +1,54 @@
+#include "bench_common.hpp"
+#include <ics_dict_vector.hpp>
+
+#include <string>
+
+// Usage: bench_dictVector [elements] [distinct]
+namespace {
+    size_t string_heap_bytes(const std::string& s) {
+        // strings that fit the small-string buffer own no heap memory
+        return s.capacity() > 15 ? s.capacity() + 1 : 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, 5000000);
+    size_t distinct = arg_size(argc, argv, 2, 300);
+
+    Vector<std::string> names;
+    for (size_t i = 0; i < distinct; ++i) {
+        names.push_back("service-status-" + std::to_string(i) + "-healthy");
+    }
+
+    Vector<std::string> plain;
+    DictVector<std::string> dict;
+    double plain_build = time_ms([&] {
+        for (size_t i = 0; i < n; ++i) plain.push_back(names[(i * 7919) % distinct]);
+    });
+    double dict_build = time_ms([&] {
+        for (size_t i = 0; i < n; ++i) dict.push_back(names[(i * 7919) % distinct]);
+    });
+
+    size_t plain_bytes = plain.capacity() * sizeof(std::string);
+    for (const std::string& s : plain) plain_bytes += string_heap_bytes(s);
+    size_t dict_bytes = dict.memory_bytes();
+    for (const std::string& s : dict.dictionary()) dict_bytes += string_heap_bytes(s);
+
+    const std::string& needle = names[distinct / 2];
+    size_t plain_hits = 0;
+    size_t dict_hits = 0;
+    double plain_scan = time_ms([&] {
+        for (const std::string& s : plain) plain_hits += s == needle;
+    });
+    double dict_scan = time_ms([&] { dict_hits = dict.count_equal(needle); });
+    do_not_optimize(plain_hits);
+    do_not_optimize(dict_hits);
+
+    std::printf("elements %zu, distinct %zu, code width %zu bytes\n", n, distinct, dict.code_width());
+    std::printf("%-22s %12s %12s %12s\n", "", "build ms", "MiB", "scan ms");
+    std::printf("%-22s %12.1f %12.1f %12.2f\n", "Vector<std::string>", plain_build,
+                plain_bytes / 1048576.0, plain_scan);
+    std::printf("%-22s %12.1f %12.1f %12.2f\n", "DictVector<std::string>", dict_build,
+                dict_bytes / 1048576.0, dict_scan);
+    return plain_hits == dict_hits ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+#include "bench_common.hpp"
+#include <ics_mapped_vector.hpp>
+
+#include <numeric>
+#include <string>
+
+// Usage: bench_mappedVector [elements] [path]
+// Time to first result for a full sum and for a few random lookups, loading
+// the file with load_binary versus mapping it with MappedVectorView.
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, size_t{64} << 20);
+    std::string path = argc > 2 ? argv[2] : "/tmp/ics_bench_mapped_vector.bin";
+
+    Vector<uint64_t> values;
+    uint64_t* slots = values.append_uninitialized(n);
+    for (size_t i = 0; i < n; ++i) slots[i] = i * 2654435761u;
+    save_binary(values, path);
+    values = Vector<uint64_t>();
+
+    uint64_t loaded_sum = 0;
+    double load_scan = time_ms([&] {
+        Vector<uint64_t> loaded = load_binary<uint64_t>(path);
+        loaded_sum = std::accumulate(loaded.begin(), loaded.end(), uint64_t{0});
+    });
+    uint64_t mapped_sum = 0;
+    double map_scan = time_ms([&] {
+        MappedVectorView<uint64_t> view(path, AccessPattern::sequential);
+        mapped_sum = std::accumulate(view.begin(), view.end(), uint64_t{0});
+    });
+
+    uint64_t probes = 0;
+    double load_probe = time_ms([&] {
+        Vector<uint64_t> loaded = load_binary<uint64_t>(path);
+        for (size_t i = 0; i < 1000; ++i) probes += loaded[(i * 7919) % n];
+    });
+    double map_probe = time_ms([&] {
+        MappedVectorView<uint64_t> view(path, AccessPattern::random);
+        for (size_t i = 0; i < 1000; ++i) probes += view[(i * 7919) % n];
+    });
+    do_not_optimize(probes);
+    ::unlink(path.c_str());
+
+    std::printf("%.0f MiB of uint64_t\n", n * sizeof(uint64_t) / 1048576.0);
+    std::printf("%-14s %14s %14s\n", "", "load ms", "map ms");
+    std::printf("%-14s %14.1f %14.1f\n", "full scan", load_scan, map_scan);
+    std::printf("%-14s %14.1f %14.1f\n", "1000 lookups", load_probe, map_probe);
+    return loaded_sum == mapped_sum ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+#include "bench_common.hpp"
+#include <ics_mpmc_queue.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Usage: bench_mpmcQueue [items] [max threads per side] [capacity]
+// Equal numbers of producers and consumers pass a fixed total of items
+// through a bounded queue: a Vector under a mutex with two condition
+// variables, and an MpmcQueue with its blocking push/pop. Thread counts per
+// side double from one up to the maximum.
+namespace {
+    class LockedQueue {
+    private:
+        Vector<uint64_t> m_values;
+        size_t m_capacity;
+        std::mutex m_mutex;
+        std::condition_variable m_not_full;
+        std::condition_variable m_not_empty;
+
+    public:
+        explicit LockedQueue(size_t capacity) : m_capacity(capacity) {}
+
+        void push(uint64_t value) {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_not_full.wait(lock, [&] { return m_values.size() < m_capacity; });
+            m_values.push_back(value);
+            m_not_empty.notify_one();
+        }
+
+        uint64_t pop() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_not_empty.wait(lock, [&] { return !m_values.empty(); });
+            uint64_t value = m_values[0];
+            m_values.erase(m_values.begin(), m_values.begin() + 1);
+            m_not_full.notify_one();
+            return value;
+        }
+    };
+
+    template <typename Queue>
+    double transfer(Queue& queue, size_t pairs, size_t per_producer, uint64_t& sum) {
+        std::atomic<uint64_t> total{0};
+        double ms = time_ms([&] {
+            Vector<std::thread> threads;
+            for (size_t p = 0; p < pairs; ++p) {
+                threads.push_back(std::thread([&] {
+                    for (size_t i = 0; i < per_producer; ++i) queue.push(uint64_t{i});
+                }));
+                threads.push_back(std::thread([&] {
+                    uint64_t local = 0;
+                    for (size_t i = 0; i < per_producer; ++i) local += queue.pop();
+                    total.fetch_add(local);
+                }));
+            }
+            for (std::thread& thread : threads) thread.join();
+        });
+        sum = total.load();
+        return ms;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, size_t{2} << 20);
+    size_t max_pairs = arg_size(argc, argv, 2, 32);
+    size_t capacity = arg_size(argc, argv, 3, 1024);
+
+    std::printf("%zu items, capacity %zu, %u hardware threads\n", n, capacity, std::thread::hardware_concurrency());
+    std::printf("%12s %16s %16s\n", "prod/cons", "mutex+cv M/s", "MpmcQueue M/s");
+    for (size_t pairs = 1; pairs <= max_pairs; pairs *= 2) {
+        size_t per_producer = n / pairs;
+        LockedQueue locked(capacity);
+        MpmcQueue<uint64_t> lock_free(capacity);
+        uint64_t locked_sum = 0;
+        uint64_t lock_free_sum = 0;
+        double locked_ms = transfer(locked, pairs, per_producer, locked_sum);
+        double lock_free_ms = transfer(lock_free, pairs, per_producer, lock_free_sum);
+        if (locked_sum != lock_free_sum) return 1;
+        double items = static_cast<double>(per_producer * pairs);
+        std::printf("%7zu/%-4zu %16.1f %16.1f\n", pairs, pairs, items / locked_ms / 1e3, items / lock_free_ms / 1e3);
+    }
+    return 0;
+}
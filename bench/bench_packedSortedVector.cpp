@@ -0,0 +1,82 @@
+#include "bench_common.hpp"
+#include <ics_packed_sorted_vector.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+
+// Usage: bench_packedSortedVector [elements] [average gap]
+namespace {
+    Vector<uint32_t> posting_list(size_t n, uint32_t average_gap, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<uint32_t> gap(1, 2 * average_gap - 1);
+        Vector<uint32_t> values(n);
+        uint32_t current = 0;
+        for (size_t i = 0; i < n; ++i) {
+            current += gap(rng);
+            values.push_back(current);
+        }
+        return values;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, 10000000);
+    uint32_t average_gap = static_cast<uint32_t>(arg_size(argc, argv, 2, 8));
+
+    Vector<uint32_t> lhs = posting_list(n, average_gap, 1);
+    Vector<uint32_t> rhs = posting_list(n / 10, average_gap * 10, 2);
+    PackedSortedVector packed_lhs;
+    double build = time_ms([&] { packed_lhs = PackedSortedVector(lhs); });
+    PackedSortedVector packed_rhs(rhs);
+
+    std::mt19937 rng(3);
+    Vector<uint32_t> probes(1000000);
+    for (size_t i = 0; i < 1000000; ++i) probes.push_back(static_cast<uint32_t>(rng()) % lhs.back());
+
+    size_t plain_sum = 0;
+    size_t packed_sum = 0;
+    const uint32_t* first = lhs.data();
+    const uint32_t* last = lhs.data() + lhs.size();
+    double plain_lookup = time_ms([&] {
+        for (uint32_t probe : probes) plain_sum += std::lower_bound(first, last, probe) - first;
+    });
+    double packed_lookup = time_ms([&] {
+        for (uint32_t probe : probes) packed_sum += packed_lhs.lower_bound(probe);
+    });
+
+    Vector<uint32_t> plain_common(rhs.size());
+    size_t plain_count = 0;
+    double plain_intersect = time_ms([&] {
+        const uint32_t* a = lhs.data();
+        const uint32_t* b = rhs.data();
+        const uint32_t* a_end = a + lhs.size();
+        const uint32_t* b_end = b + rhs.size();
+        while (a != a_end && b != b_end) {
+            if (*a < *b) {
+                ++a;
+            } else if (*b < *a) {
+                ++b;
+            } else {
+                plain_common.push_back(*a);
+                ++a;
+                ++b;
+            }
+        }
+        plain_count = plain_common.size();
+    });
+    size_t packed_count = 0;
+    double packed_intersect = time_ms([&] { packed_count = intersect(packed_lhs, packed_rhs).size(); });
+    do_not_optimize(plain_sum);
+    do_not_optimize(packed_sum);
+
+    size_t plain_bytes = lhs.size() * sizeof(uint32_t);
+    std::printf("elements %zu, average gap %u, build %.1f ms\n", n, average_gap, build);
+    std::printf("%-20s %12s %16s %16s\n", "", "MiB", "1M lookups ms", "intersect ms");
+    std::printf("%-20s %12.1f %16.1f %16.1f\n", "Vector<uint32_t>", plain_bytes / 1048576.0,
+                plain_lookup, plain_intersect);
+    std::printf("%-20s %12.1f %16.1f %16.1f\n", "PackedSortedVector",
+                packed_lhs.memory_bytes() / 1048576.0, packed_lookup, packed_intersect);
+    std::printf("compression %.2fx\n", static_cast<double>(plain_bytes) / packed_lhs.memory_bytes());
+    return plain_sum == packed_sum && plain_count == packed_count ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+#include "bench_common.hpp"
+#include <ics_parallel_algorithms.hpp>
+
+#include <cmath>
+#include <thread>
+
+// Usage: bench_parallelAlgorithms [elements] [max threads]
+// Times each parallel algorithm on a Vector<double> with pools of doubling
+// size, next to a plain serial loop.
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, size_t{32} << 20);
+    size_t max_threads = arg_size(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+
+    Vector<double> values;
+    for (size_t i = 0; i < n; ++i) values.push_back(static_cast<double>(i % 1000));
+    auto plus = [](double a, double b) { return a + b; };
+
+    double serial_sum = 0;
+    double serial_reduce = time_ms([&] {
+        for (double value : values) serial_sum += value;
+    });
+    double serial_transform = time_ms([&] {
+        Vector<double> roots = values;
+        for (size_t i = 0; i < n; ++i) roots[i] = std::sqrt(values[i]);
+        do_not_optimize(roots[n / 2]);
+    });
+
+    std::printf("%zu doubles, %u hardware threads (serial: reduce %.1f ms, transform %.1f ms)\n", n,
+                std::thread::hardware_concurrency(), serial_reduce, serial_transform);
+    std::printf("%8s %10s %10s %10s %10s %10s %10s\n", "threads", "for_each", "transform", "reduce", "count_if",
+                "fill", "copy");
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        ThreadPool pool(threads);
+        ParallelOptions options{0, &pool};
+        Vector<double> target = values;
+        double for_each_ms = time_ms([&] { parallel_for_each(target, [](double& value) { value += 1.0; }, options); });
+        double transform_ms = time_ms([&] {
+            Vector<double> roots = parallel_transform(values, [](double value) { return std::sqrt(value); }, options);
+            do_not_optimize(roots[n / 2]);
+        });
+        double sum = 0;
+        double reduce_ms = time_ms([&] { sum = parallel_reduce(values, 0.0, plus, options); });
+        size_t big = 0;
+        double count_ms = time_ms([&] {
+            big = parallel_count_if(values, [](double value) { return value > 500; }, options);
+        });
+        double fill_ms = time_ms([&] { parallel_fill(target, 1.0, options); });
+        double copy_ms = time_ms([&] {
+            Vector<double> copy = parallel_copy(values, options);
+            do_not_optimize(copy[n / 2]);
+        });
+        if (sum != serial_sum) return 1;
+        do_not_optimize(big);
+        std::printf("%8zu %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", threads, for_each_ms, transform_ms, reduce_ms,
+                    count_ms, fill_ms, copy_ms);
+    }
+    return 0;
+}
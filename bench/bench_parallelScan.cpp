@@ -0,0 +1,60 @@
+#include "bench_common.hpp"
+#include <ics_parallel_scan.hpp>
+
+#include <cstdint>
+#include <thread>
+
+// Usage: bench_parallelScan [elements] [max threads]
+// Times inclusive scan, copy_if and partition on a Vector<uint32_t> with
+// pools of doubling size, next to a serial scan loop and a push_back filter.
+// 1e9 elements need about 12 GiB.
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, size_t{100} * 1000 * 1000);
+    size_t max_threads = arg_size(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+
+    Vector<uint32_t> values;
+    for (size_t i = 0; i < n; ++i) values.push_back(static_cast<uint32_t>((i * 2654435761u) % 1000));
+    auto keep = [](uint32_t value) { return value < 300; };
+
+    Vector<uint32_t> serial_sums(n);
+    double serial_scan = time_ms([&] {
+        serial_sums.append_uninitialized(n);
+        uint32_t running = 0;
+        for (size_t i = 0; i < n; ++i) {
+            running += values[i];
+            serial_sums[i] = running;
+        }
+        do_not_optimize(serial_sums[n - 1]);
+    });
+    size_t serial_kept = 0;
+    double serial_filter = time_ms([&] {
+        Vector<uint32_t> kept;
+        for (uint32_t value : values) {
+            if (keep(value)) kept.push_back(value);
+        }
+        serial_kept = kept.size();
+    });
+
+    std::printf("%zu uint32, %u hardware threads (serial: scan %.1f ms, push_back filter %.1f ms)\n", n,
+                std::thread::hardware_concurrency(), serial_scan, serial_filter);
+    std::printf("%8s %10s %10s %10s %10s\n", "threads", "scan", "exclusive", "copy_if", "partition");
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        ThreadPool pool(threads);
+        ParallelOptions options{0, &pool};
+        Vector<uint32_t> sums;
+        double scan_ms = time_ms([&] { sums = parallel_inclusive_scan(values, std::plus<>(), options); });
+        if (sums[n - 1] != serial_sums[n - 1]) return 1;
+        double exclusive_ms = time_ms([&] {
+            Vector<uint32_t> offsets = parallel_exclusive_scan(values, 0, std::plus<>(), options);
+            do_not_optimize(offsets[n - 1]);
+        });
+        size_t kept = 0;
+        double copy_ms = time_ms([&] { kept = parallel_copy_if(values, keep, options).size(); });
+        if (kept != serial_kept) return 1;
+        Vector<uint32_t> target = values;
+        double partition_ms = time_ms([&] { kept = parallel_partition(target, keep, options); });
+        if (kept != serial_kept) return 1;
+        std::printf("%8zu %10.1f %10.1f %10.1f %10.1f\n", threads, scan_ms, exclusive_ms, copy_ms, partition_ms);
+    }
+    return 0;
+}
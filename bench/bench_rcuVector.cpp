@@ -0,0 +1,74 @@
+#include "bench_common.hpp"
+#include <ics_rcu_vector.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <shared_mutex>
+#include <thread>
+
+// Usage: bench_rcuVector [elements] [max threads] [ms per run]
+// Reader threads look up entries of a table for a fixed time while one
+// writer replaces an entry every millisecond: behind a shared_mutex, and
+// in an RcuVector. Reports millions of lookups per second per thread count.
+namespace {
+    template <typename Lookup, typename Write>
+    double reads_per_second(size_t threads, size_t ms, Lookup&& lookup, Write&& write) {
+        std::atomic<bool> done{false};
+        std::atomic<uint64_t> total{0};
+        Vector<std::thread> pool;
+        for (size_t t = 0; t < threads; ++t) {
+            pool.push_back(std::thread([&, t] {
+                uint64_t count = 0;
+                uint64_t key = t * 7919;
+                while (!done.load(std::memory_order_relaxed)) {
+                    for (int i = 0; i < 64; ++i) do_not_optimize(lookup(key++));
+                    count += 64;
+                }
+                total.fetch_add(count);
+            }));
+        }
+        // readers may starve the writer, so measure the real time
+        double elapsed = time_ms([&] {
+            auto stop = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+            for (uint64_t round = 0; std::chrono::steady_clock::now() < stop; ++round) {
+                write(round);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            done.store(true);
+            for (std::thread& thread : pool) thread.join();
+        });
+        return static_cast<double>(total.load()) / (elapsed / 1000.0);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, 4096);
+    size_t max_threads = arg_size(argc, argv, 2, 16);
+    size_t ms = arg_size(argc, argv, 3, 500);
+
+    Vector<uint64_t> table;
+    for (size_t i = 0; i < n; ++i) table.push_back(i);
+    RcuVector<uint64_t> rcu(table);
+    std::shared_mutex mutex;
+
+    std::printf("%zu entries, one writer every ms, %u hardware threads\n", n, std::thread::hardware_concurrency());
+    std::printf("%8s %18s %18s\n", "threads", "shared_mutex M/s", "RcuVector M/s");
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        double locked = reads_per_second(
+            threads, ms,
+            [&](uint64_t key) {
+                std::shared_lock<std::shared_mutex> lock(mutex);
+                return table[key % n];
+            },
+            [&](uint64_t round) {
+                std::unique_lock<std::shared_mutex> lock(mutex);
+                table[round % n] = round;
+            });
+        double rcu_reads = reads_per_second(
+            threads, ms,
+            [&](uint64_t key) { return rcu.read()[key % n]; },
+            [&](uint64_t round) { rcu.update([&](Vector<uint64_t>& values) { values[round % n] = round; }); });
+        std::printf("%8zu %18.1f %18.1f\n", threads, locked / 1e6, rcu_reads / 1e6);
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include "bench_common.hpp"
+#include <ics_rrb_vector.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+// Usage: bench_rrbVector [elements] [versions]
+// Keeps every version of a vector alive while changing one random element
+// per version: as full Vector copies, and as RrbVector versions sharing
+// structure. Reports heap bytes held by the versions.
+namespace {
+    std::atomic<size_t> live_bytes{0};
+}
+
+void* operator new(size_t size) {
+    void* p = std::malloc(size + 16);
+    if (p == nullptr) throw std::bad_alloc();
+    *static_cast<size_t*>(p) = size;
+    live_bytes.fetch_add(size, std::memory_order_relaxed);
+    return static_cast<char*>(p) + 16;
+}
+
+void operator delete(void* p) noexcept {
+    if (p == nullptr) return;
+    void* base = static_cast<char*>(p) - 16;
+    live_bytes.fetch_sub(*static_cast<size_t*>(base), std::memory_order_relaxed);
+    std::free(base);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    operator delete(p);
+}
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, 100000);
+    size_t versions = arg_size(argc, argv, 2, 1000);
+
+    double copy_mib = 0;
+    std::mt19937_64 rng(66);
+    double copy_ms = time_ms([&] {
+        size_t before = live_bytes.load();
+        Vector<Vector<int64_t>> history;
+        Vector<int64_t> current;
+        for (size_t i = 0; i < n; ++i) current.push_back(static_cast<int64_t>(i));
+        for (size_t v = 0; v < versions; ++v) {
+            history.push_back(current);
+            current[rng() % n] += 1;
+        }
+        copy_mib = static_cast<double>(live_bytes.load() - before) / (1 << 20);
+        do_not_optimize(history[0][0]);
+    });
+
+    double rrb_mib = 0;
+    rng.seed(66);
+    double rrb_ms = time_ms([&] {
+        size_t before = live_bytes.load();
+        Vector<RrbVector<int64_t>> history;
+        RrbVector<int64_t>::Transient builder;
+        for (size_t i = 0; i < n; ++i) builder.push_back(static_cast<int64_t>(i));
+        RrbVector<int64_t> current = builder.persistent();
+        for (size_t v = 0; v < versions; ++v) {
+            history.push_back(current);
+            size_t index = rng() % n;
+            current = current.set(index, current[index] + 1);
+        }
+        rrb_mib = static_cast<double>(live_bytes.load() - before) / (1 << 20);
+        do_not_optimize(history[0][0]);
+    });
+
+    std::printf("%zu elements, %zu versions kept\n", n, versions);
+    std::printf("%-16s %12s %12s\n", "", "ms", "MiB held");
+    std::printf("%-16s %12.1f %12.1f\n", "Vector copies", copy_ms, copy_mib);
+    std::printf("%-16s %12.1f %12.1f\n", "RrbVector", rrb_ms, rrb_mib);
+    return 0;
+}
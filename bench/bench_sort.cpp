@@ -0,0 +1,53 @@
+#include "bench_common.hpp"
+#include <ics_sort.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <thread>
+
+// Usage: bench_sort [elements] [max threads]
+// Sorts uint64_t Vectors of random, sorted, reversed and few-unique values
+// with std::sort on the raw range, the radix path (default comparator),
+// pdqsort and stable merge sort (a lambda comparator) on one thread, and the
+// parallel merge sort on the largest pool.
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, size_t{1} << 24);
+    size_t max_threads = arg_size(argc, argv, 2, std::max(1u, std::thread::hardware_concurrency()));
+
+    std::mt19937_64 rng(42);
+    Vector<uint64_t> inputs[4];
+    const char* names[4] = {"random", "sorted", "reversed", "few-unique"};
+    for (size_t i = 0; i < n; ++i) {
+        inputs[0].push_back(rng());
+        inputs[1].push_back(i);
+        inputs[2].push_back(n - i);
+        inputs[3].push_back(rng() % 8);
+    }
+    auto less = [](uint64_t a, uint64_t b) { return a < b; };
+    ThreadPool serial(1);
+    ThreadPool pool(max_threads);
+    ParallelOptions one{0, &serial};
+    ParallelOptions all{0, &pool};
+
+    std::printf("%zu uint64, %zu-thread pool for the parallel columns\n", n, max_threads);
+    std::printf("%12s %10s %10s %10s %10s %12s %12s\n", "input", "std::sort", "radix", "pdqsort", "stable", "par radix",
+                "par pdqsort");
+    for (size_t d = 0; d < 4; ++d) {
+        auto run = [&](auto sorter) {
+            Vector<uint64_t> values = inputs[d];
+            double ms = time_ms([&] { sorter(values); });
+            if (!std::is_sorted(values.data(), values.data() + n)) std::exit(1);
+            return ms;
+        };
+        double std_ms = run([](Vector<uint64_t>& values) { std::sort(&values[0], &values[0] + values.size()); });
+        double radix_ms = run([&](Vector<uint64_t>& values) { sort(values, std::less<>(), one); });
+        double pdq_ms = run([&](Vector<uint64_t>& values) { sort(values, less, one); });
+        double stable_ms = run([&](Vector<uint64_t>& values) { stable_sort(values, less, one); });
+        double par_radix_ms = run([&](Vector<uint64_t>& values) { sort(values, std::less<>(), all); });
+        double par_pdq_ms = run([&](Vector<uint64_t>& values) { sort(values, less, all); });
+        std::printf("%12s %10.1f %10.1f %10.1f %10.1f %12.1f %12.1f\n", names[d], std_ms, radix_ms, pdq_ms, stable_ms,
+                    par_radix_ms, par_pdq_ms);
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "bench_common.hpp"
+#include <ics_spsc_ring.hpp>
+
+#include <mutex>
+#include <thread>
+
+// Usage: bench_spscRing [items] [batch]
+// A producer thread hands integers to a consumer thread: through a
+// mutex-guarded Vector drained from the front with erase, and through an
+// SpscRing one at a time and in batches. Reports millions of items per
+// second. A side that finds the ring full or empty yields, so the numbers
+// stay meaningful when both threads share a core.
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, size_t{50} << 20);
+    size_t batch = arg_size(argc, argv, 2, 256);
+    size_t queue_n = n / 16;  // the Vector queue is far slower
+
+    Vector<uint64_t> queue;
+    std::mutex mutex;
+    uint64_t queue_sum = 0;
+    double queue_ms = time_ms([&] {
+        std::thread producer([&] {
+            for (size_t i = 0; i < queue_n; ++i) {
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push_back(i);
+            }
+        });
+        for (size_t taken = 0; taken < queue_n;) {
+            size_t k;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                k = queue.size() < batch ? queue.size() : batch;
+                for (size_t i = 0; i < k; ++i) queue_sum += queue[i];
+                if (k > 0) queue.erase(queue.begin(), queue.begin() + k);
+            }
+            if (k == 0) std::this_thread::yield();
+            taken += k;
+        }
+        producer.join();
+    });
+
+    SpscRing<uint64_t> ring(4096);
+    uint64_t single_sum = 0;
+    double single_ms = time_ms([&] {
+        std::thread producer([&] {
+            for (size_t i = 0; i < n;) {
+                if (ring.try_push(uint64_t{i})) {
+                    ++i;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        uint64_t value;
+        for (size_t taken = 0; taken < n;) {
+            if (ring.try_pop(value)) {
+                single_sum += value;
+                ++taken;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+    });
+
+    uint64_t batch_sum = 0;
+    double batch_ms = time_ms([&] {
+        std::thread producer([&] {
+            Vector<uint64_t> values;
+            for (size_t i = 0; i < batch; ++i) values.push_back(0);
+            for (size_t i = 0; i < n;) {
+                size_t k = n - i < batch ? n - i : batch;
+                for (size_t j = 0; j < k; ++j) values[j] = i + j;
+                size_t pushed = 0;
+                while (pushed < k) {
+                    size_t moved = ring.push_n(std::span<uint64_t>(&values[pushed], k - pushed));
+                    if (moved == 0) std::this_thread::yield();
+                    pushed += moved;
+                }
+                i += k;
+            }
+        });
+        Vector<uint64_t> out;
+        for (size_t i = 0; i < batch; ++i) out.push_back(0);
+        for (size_t taken = 0; taken < n;) {
+            size_t k = ring.pop_n(std::span<uint64_t>(&out[0], batch));
+            if (k == 0) std::this_thread::yield();
+            for (size_t j = 0; j < k; ++j) batch_sum += out[j];
+            taken += k;
+        }
+        producer.join();
+    });
+
+    if (single_sum != batch_sum) return 1;
+    do_not_optimize(queue_sum);
+    std::printf("%zu items (%zu through the Vector queue), batch %zu, %u hardware threads\n", n, queue_n, batch,
+                std::thread::hardware_concurrency());
+    std::printf("%-22s %12s\n", "", "M items/s");
+    std::printf("%-22s %12.1f\n", "mutex + Vector erase", queue_n / queue_ms / 1e3);
+    std::printf("%-22s %12.1f\n", "SpscRing single", n / single_ms / 1e3);
+    std::printf("%-22s %12.1f\n", "SpscRing push_n/pop_n", n / batch_ms / 1e3);
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include "bench_common.hpp"
+#include <ics_vector.hpp>
+
+#include <fstream>
+#include <random>
+
+// Usage: bench_textFormat [elements]
+// Dumps Vectors to /dev/null through the element-by-element stream loop that
+// operator<< used to run and through the current operator<<.
+namespace {
+    template <typename T>
+    void compare(const char* label, const Vector<T>& values) {
+        std::ofstream sink("/dev/null");
+        double streamed = time_ms([&] {
+            for (const T& value : values) sink << value << " ";
+            sink.flush();
+        });
+        double formatted = time_ms([&] {
+            sink << values;
+            sink.flush();
+        });
+        std::printf("%-10s %14.1f %14.1f %9.1fx\n", label, streamed, formatted, streamed / formatted);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, 10000000);
+    std::mt19937_64 rng(7);
+
+    Vector<int64_t> ints(n);
+    Vector<double> doubles(n);
+    std::uniform_real_distribution<double> real(-1e6, 1e6);
+    for (size_t i = 0; i < n; ++i) {
+        ints.push_back(static_cast<int64_t>(rng() >> 20));
+        doubles.push_back(real(rng));
+    }
+
+    std::printf("%zu elements\n", n);
+    std::printf("%-10s %14s %14s %10s\n", "", "stream ms", "operator<< ms", "speedup");
+    compare("int64_t", ints);
+    compare("double", doubles);
+    return 0;
+}
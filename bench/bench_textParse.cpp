@@ -0,0 +1,49 @@
+#include "bench_common.hpp"
+#include <ics_text_parse.hpp>
+
+#include <random>
+#include <sstream>
+#include <string>
+
+// Usage: bench_textParse [elements]
+// Reads operator<< output back with an istream >> loop and with parse_into.
+namespace {
+    template <typename T>
+    void compare(const char* label, const Vector<T>& values) {
+        std::ostringstream os;
+        os << values;
+        std::string text = os.str();
+
+        Vector<T> streamed;
+        double stream_ms = time_ms([&] {
+            std::istringstream is(text);
+            T value;
+            while (is >> value) streamed.push_back(value);
+        });
+        Vector<T> parsed;
+        double parse_ms = time_ms([&] { parse_into(parsed, text); });
+
+        std::printf("%-10s %10.1f %14.1f %14.1f %9.1fx\n", label, text.size() / 1048576.0, stream_ms,
+                    parse_ms, stream_ms / parse_ms);
+        do_not_optimize(streamed.size() + parsed.size());
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, 10000000);
+    std::mt19937_64 rng(11);
+
+    Vector<int64_t> ints(n);
+    Vector<double> doubles(n);
+    std::uniform_real_distribution<double> real(-1e6, 1e6);
+    for (size_t i = 0; i < n; ++i) {
+        ints.push_back(static_cast<int64_t>(rng() >> 20));
+        doubles.push_back(real(rng));
+    }
+
+    std::printf("%zu elements\n", n);
+    std::printf("%-10s %10s %14s %14s %10s\n", "", "MiB", "istream ms", "parse_into ms", "speedup");
+    compare("int64_t", ints);
+    compare("double", doubles);
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include "bench_common.hpp"
+#include <ics_thread_pool.hpp>
+
+#include <thread>
+
+// Usage: bench_threadPool [elements] [grain] [max threads]
+// Sums a Vector by recursive halving with parallel_invoke down to grain
+// elements, and computes fib(30) spawning a task per call above a cutoff,
+// on pools of doubling size. Reports times and the pool's steal counters.
+namespace {
+    int64_t sum(ThreadPool& pool, const int64_t* first, size_t count, size_t grain) {
+        if (count <= grain) {
+            int64_t total = 0;
+            for (size_t i = 0; i < count; ++i) total += first[i];
+            return total;
+        }
+        int64_t left = 0;
+        int64_t right = 0;
+        size_t half = count / 2;
+        parallel_invoke(pool, [&] { left = sum(pool, first, half, grain); },
+                        [&] { right = sum(pool, first + half, count - half, grain); });
+        return left + right;
+    }
+
+    long fib(ThreadPool& pool, int n) {
+        if (n < 16) {
+            return n < 2 ? n : fib(pool, n - 1) + fib(pool, n - 2);
+        }
+        long a = 0;
+        long b = 0;
+        parallel_invoke(pool, [&] { a = fib(pool, n - 1); }, [&] { b = fib(pool, n - 2); });
+        return a + b;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, size_t{32} << 20);
+    size_t grain = arg_size(argc, argv, 2, size_t{1} << 14);
+    size_t max_threads = arg_size(argc, argv, 3, std::max(1u, std::thread::hardware_concurrency()));
+
+    Vector<int64_t> values;
+    for (size_t i = 0; i < n; ++i) values.push_back(static_cast<int64_t>(i & 1023));
+    int64_t expected = 0;
+    double serial_ms = time_ms([&] {
+        for (int64_t value : values) expected += value;
+    });
+    std::printf("%zu elements, grain %zu, serial sum %.1f ms\n", n, grain, serial_ms);
+    std::printf("%8s %10s %10s %10s %10s %10s\n", "threads", "sum ms", "fib ms", "tasks", "stolen", "sleeps");
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        ThreadPool pool(threads);
+        int64_t total = 0;
+        double sum_ms = time_ms([&] { total = sum(pool, values.data(), n, grain); });
+        long f = 0;
+        double fib_ms = time_ms([&] { f = fib(pool, 30); });
+        if (total != expected || f != 832040) return 1;
+        ThreadPoolStats stats = pool.stats();
+        std::printf("%8zu %10.1f %10.1f %10llu %10llu %10llu\n", threads, sum_ms, fib_ms,
+                    static_cast<unsigned long long>(stats.executed), static_cast<unsigned long long>(stats.stolen),
+                    static_cast<unsigned long long>(stats.sleeps));
+    }
+    return 0;
+}
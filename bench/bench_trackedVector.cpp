@@ -0,0 +1,54 @@
+#include "bench_common.hpp"
+#include <ics_tracked_vector.hpp>
+
+#include <random>
+#include <string>
+#include <sys/stat.h>
+
+// Usage: bench_trackedVector [elements] [updates] [path]
+// Checkpoints a vector after a round of scattered updates, once as a full
+// save_binary and once as an incremental write_checkpoint.
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, size_t{32} << 20);
+    size_t updates = arg_size(argc, argv, 2, 1000);
+    std::string path = argc > 3 ? argv[3] : "/tmp/ics_bench_tracked_vector.bin";
+    std::mt19937_64 rng(23);
+    ::unlink(path.c_str());
+
+    Vector<int64_t> values;
+    int64_t* slots = values.append_uninitialized(n);
+    for (size_t i = 0; i < n; ++i) slots[i] = static_cast<int64_t>(i);
+    TrackedVector<int64_t> tracked(std::move(values));
+    tracked.clear_dirty();
+
+    double update_ms = time_ms([&] {
+        for (size_t i = 0; i < updates; ++i) tracked[rng() % n] += 1;
+    });
+    struct stat info;
+
+    double full_ms = time_ms([&] {
+        ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_WRONLY | O_CREAT | O_TRUNC);
+        write_binary(fd.get(), tracked.values());
+        ::fsync(fd.get());
+    });
+    ::stat(path.c_str(), &info);
+    double full_mib = static_cast<double>(info.st_size) / 1048576.0;
+
+    size_t blocks = 0;
+    ::unlink(path.c_str());
+    double delta_ms = time_ms([&] {
+        ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_WRONLY | O_CREAT | O_TRUNC);
+        blocks = tracked.write_checkpoint(fd.get());
+        ::fsync(fd.get());
+    });
+    ::stat(path.c_str(), &info);
+    double delta_mib = static_cast<double>(info.st_size) / 1048576.0;
+    ::unlink(path.c_str());
+
+    std::printf("%zu elements, %zu updates (%.1f ms), %zu dirty blocks of %zu\n", n, updates, update_ms, blocks,
+                tracked.block_size());
+    std::printf("%-14s %12s %12s\n", "", "MiB", "ms");
+    std::printf("%-14s %12.2f %12.1f\n", "save_binary", full_mib, full_ms);
+    std::printf("%-14s %12.2f %12.1f\n", "checkpoint", delta_mib, delta_ms);
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include "bench_common.hpp"
+#include <ics_vector_io.hpp>
+
+#include <string>
+
+// Usage: bench_vectorIo [elements] [path]
+// Compares save_binary/load_binary against a bare write/read of the same
+// bytes. Point path at the device under test; the default lands in /tmp.
+int main(int argc, char** argv) {
+    size_t n = arg_size(argc, argv, 1, size_t{64} << 20);
+    std::string path = argc > 2 ? argv[2] : "/tmp/ics_bench_vector_io.bin";
+
+    Vector<double> values;
+    double* slots = values.append_uninitialized(n);
+    for (size_t i = 0; i < n; ++i) slots[i] = static_cast<double>(i);
+    double mib = n * sizeof(double) / 1048576.0;
+
+    double raw_write = time_ms([&] {
+        ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_WRONLY | O_CREAT | O_TRUNC);
+        ics_detail::write_all(fd.get(), values.data(), n * sizeof(double));
+        ::fsync(fd.get());
+    });
+    Vector<double> raw(n);
+    double raw_read = time_ms([&] {
+        ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_RDONLY);
+        ics_detail::read_exact(fd.get(), raw.append_uninitialized(n), n * sizeof(double));
+    });
+
+    double vector_write = time_ms([&] {
+        ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_WRONLY | O_CREAT | O_TRUNC);
+        write_binary(fd.get(), values);
+        ::fsync(fd.get());
+    });
+    Vector<double> loaded;
+    double vector_read = time_ms([&] { loaded = load_binary<double>(path); });
+    ::unlink(path.c_str());
+
+    std::printf("%.0f MiB of double\n", mib);
+    std::printf("%-16s %14s %14s\n", "", "write MiB/s", "read MiB/s");
+    std::printf("%-16s %14.0f %14.0f\n", "raw write/read", mib / raw_write * 1000, mib / raw_read * 1000);
+    std::printf("%-16s %14.0f %14.0f\n", "binary Vector", mib / vector_write * 1000, mib / vector_read * 1000);
+    return loaded == values ? 0 : 1;
+}
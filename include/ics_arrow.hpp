@@ -0,0 +1,261 @@
+#ifndef ICS_ARROW_HPP
+#define ICS_ARROW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "ics_nullable_vector.hpp"
+#include "ics_vector.hpp"
+#include "vector_exception.hpp"
+
+// Arrow C Data Interface structures, verbatim from the Arrow specification so
+// they are interchangeable with any other definition guarded the same way.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+};
+
+#endif
+
+// Arrow primitive types that map one-to-one onto a C++ arithmetic type. bool
+// is excluded because Arrow stores booleans as a bitmap.
+template <typename T>
+concept ArrowPrimitive = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>
+    && (std::is_integral_v<T> || sizeof(T) == 4 || sizeof(T) == 8);
+
+template <ArrowPrimitive T>
+constexpr const char* arrow_format() noexcept {
+    if constexpr (std::is_floating_point_v<T>) {
+        return sizeof(T) == 4 ? "f" : "g";
+    } else if constexpr (std::is_signed_v<T>) {
+        return sizeof(T) == 1 ? "c" : sizeof(T) == 2 ? "s" : sizeof(T) == 4 ? "i" : "l";
+    } else {
+        return sizeof(T) == 1 ? "C" : sizeof(T) == 2 ? "S" : sizeof(T) == 4 ? "I" : "L";
+    }
+}
+
+namespace ics_detail {
+    // Owns the exported container; the array's private_data points here.
+    template <typename Container>
+    struct ArrowExport {
+        Container values;
+        const void* buffers[2];
+    };
+
+    template <typename Container>
+    void release_arrow_array(ArrowArray* array) {
+        delete static_cast<ArrowExport<Container>*>(array->private_data);
+        array->release = nullptr;
+    }
+
+    inline void release_arrow_schema(ArrowSchema* schema) {
+        schema->release = nullptr;
+    }
+
+    template <ArrowPrimitive T>
+    void fill_arrow_schema(ArrowSchema* schema, int64_t flags) noexcept {
+        schema->format = arrow_format<T>();
+        schema->name = nullptr;
+        schema->metadata = nullptr;
+        schema->flags = flags;
+        schema->n_children = 0;
+        schema->children = nullptr;
+        schema->dictionary = nullptr;
+        schema->release = release_arrow_schema;
+        schema->private_data = nullptr;
+    }
+
+    template <typename Container>
+    void fill_arrow_array(ArrowArray* array, ArrowExport<Container>* owner, size_t length,
+                          size_t null_count) noexcept {
+        array->length = static_cast<int64_t>(length);
+        array->null_count = static_cast<int64_t>(null_count);
+        array->offset = 0;
+        array->n_buffers = 2;
+        array->n_children = 0;
+        array->buffers = owner->buffers;
+        array->children = nullptr;
+        array->dictionary = nullptr;
+        array->release = release_arrow_array<Container>;
+        array->private_data = owner;
+    }
+}
+
+// Moves vec into a heap-allocated owner referenced by out_array, so the
+// consumer reads the original buffer without a copy. The buffer is freed when
+// the consumer calls out_array->release.
+template <ArrowPrimitive T>
+void export_arrow(Vector<T>&& vec, ArrowArray* out_array, ArrowSchema* out_schema) {
+    auto* owner = new ics_detail::ArrowExport<Vector<T>>{std::move(vec), {nullptr, nullptr}};
+    owner->buffers[1] = owner->values.data();
+    ics_detail::fill_arrow_array(out_array, owner, owner->values.size(), 0);
+    ics_detail::fill_arrow_schema<T>(out_schema, 0);
+}
+
+template <ArrowPrimitive T>
+void export_arrow(NullableVector<T>&& vec, ArrowArray* out_array, ArrowSchema* out_schema) {
+    auto* owner = new ics_detail::ArrowExport<NullableVector<T>>{std::move(vec), {nullptr, nullptr}};
+    // the validity buffer may be omitted when there are no nulls
+    owner->buffers[0] = owner->values.null_count() > 0 ? owner->values.validity() : nullptr;
+    owner->buffers[1] = owner->values.data();
+    ics_detail::fill_arrow_array(out_array, owner, owner->values.size(),
+                                 owner->values.null_count());
+    ics_detail::fill_arrow_schema<T>(out_schema, ARROW_FLAG_NULLABLE);
+}
+
+// Read-only view that adopts an imported Arrow primitive array without
+// copying. The array is moved in (its release callback is taken over) and
+// released when the view is destroyed.
+template <ArrowPrimitive T>
+class ArrowVectorView {
+private:
+    ArrowArray m_array;
+    const T* m_data;
+    size_t m_size;
+
+    void release() noexcept {
+        if (m_array.release != nullptr) {
+            m_array.release(&m_array);
+        }
+    }
+
+public:
+    // Validates the array against schema and T before taking ownership, so
+    // on a mismatch the caller still owns array.
+    ArrowVectorView(ArrowArray* array, const ArrowSchema* schema) {
+        if (array == nullptr || array->release == nullptr) {
+            throw VectorException("released arrow array");
+        }
+        if (schema == nullptr || schema->format == nullptr) {
+            throw VectorException("malformed arrow schema");
+        }
+        if (std::strcmp(schema->format, arrow_format<T>()) != 0) {
+            throw VectorException("arrow format mismatch");
+        }
+        if (array->n_buffers != 2 || array->buffers == nullptr || array->length < 0 || array->offset < 0) {
+            throw VectorException("malformed arrow array");
+        }
+        if (array->null_count != 0 && array->buffers[0] != nullptr) {
+            throw VectorException("arrow array with nulls");
+        }
+
+        m_array = *array;
+        array->release = nullptr;
+        m_size = static_cast<size_t>(m_array.length);
+        const T* values = static_cast<const T*>(m_array.buffers[1]);
+        m_data = values == nullptr ? nullptr : values + m_array.offset;
+    }
+
+    ArrowVectorView(const ArrowVectorView&) = delete;
+    ArrowVectorView& operator=(const ArrowVectorView&) = delete;
+
+    ArrowVectorView(ArrowVectorView&& other) noexcept
+        : m_array(other.m_array), m_data(other.m_data), m_size(other.m_size) {
+        other.m_array.release = nullptr;
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+
+    ArrowVectorView& operator=(ArrowVectorView&& other) noexcept {
+        if (this != &other) {
+            release();
+            m_array = other.m_array;
+            m_data = other.m_data;
+            m_size = other.m_size;
+            other.m_array.release = nullptr;
+            other.m_data = nullptr;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+    ~ArrowVectorView() noexcept {
+        release();
+    }
+
+    size_t size() const noexcept {
+        return m_size;
+    }
+
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    const T* data() const noexcept {
+        return m_data;
+    }
+
+    const T* begin() const noexcept {
+        return m_data;
+    }
+
+    const T* end() const noexcept {
+        return m_data == nullptr ? nullptr : m_data + m_size;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return m_data[index];
+    }
+
+    const T& at(size_t index) const {
+        if (index >= m_size) {
+            throw VectorException("out of bounds");
+        }
+        return m_data[index];
+    }
+
+    Vector<T> to_vector() const {
+        Vector<T> result(m_size);
+        for (size_t i = 0; i < m_size; ++i) {
+            result.push_back(m_data[i]);
+        }
+        return result;
+    }
+
+    bool operator==(const Vector<T>& other) const noexcept {
+        if (m_size != other.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < m_size; ++i) {
+            if (!(m_data[i] == other[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const Vector<T>& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+#endif
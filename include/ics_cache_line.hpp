@@ -0,0 +1,35 @@
+#ifndef ICS_CACHE_LINE_HPP
+#define ICS_CACHE_LINE_HPP
+
+#include <cstddef>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace ics_detail {
+    // Fixed rather than std::hardware_destructive_interference_size, which
+    // GCC warns may differ between translation units.
+    inline constexpr size_t cache_line_size = 64;
+
+    // A value on cache lines of its own, so writes to it never invalidate a
+    // neighbour's line.
+    template <typename T>
+    struct alignas(cache_line_size) CacheAligned {
+        T value;
+
+        template <typename... Args>
+        explicit CacheAligned(Args&&... args) : value(std::forward<Args>(args)...) {}
+    };
+
+    // Tells the CPU it is in a spin-wait loop, easing the pressure on a
+    // sibling hyperthread and on the memory bus.
+    inline void spin_pause() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif
+    }
+}
+
+#endif
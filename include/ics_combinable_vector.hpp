@@ -0,0 +1,97 @@
+#ifndef ICS_COMBINABLE_VECTOR_HPP
+#define ICS_COMBINABLE_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include "ics_parallel_algorithms.hpp"
+#include "ics_thread_pool.hpp"
+#include "ics_thread_registry.hpp"
+#include "ics_vector.hpp"
+
+// Per-thread Vectors merged once at the end. Each thread appends to its own
+// local() Vector, which sits on cache lines of its own, so collecting needs
+// no locks and causes no false sharing. combine() sums the local sizes,
+// allocates the result once and copies every thread's part into its offset,
+// in parallel for trivially copyable T.
+
+template <typename T>
+class CombinableVector {
+private:
+    ics_detail::ThreadRegistry<Vector<T>> m_locals;
+
+public:
+    // The calling thread's Vector.
+    Vector<T>& local() {
+        return m_locals.local();
+    }
+
+    // Threads that have called local().
+    size_t threads() const {
+        return m_locals.size();
+    }
+
+    size_t size() {
+        size_t total = 0;
+        m_locals.for_each([&](Vector<T>& part) {
+            total += part.size();
+        });
+        return total;
+    }
+
+    // Calls f(Vector<T>&) for each thread's Vector.
+    template <typename F>
+    void for_each_local(F&& f) {
+        m_locals.for_each(f);
+    }
+
+    // Concatenates the thread-local Vectors in the order threads first
+    // called local(). Call once the appending threads are done; pool =
+    // nullptr copies on ThreadPool::global().
+    Vector<T> combine(ThreadPool* pool = nullptr) {
+        Vector<const Vector<T>*> parts;
+        Vector<size_t> offsets;
+        size_t total = 0;
+        m_locals.for_each([&](Vector<T>& part) {
+            parts.push_back(&part);
+            offsets.push_back(total);
+            total += part.size();
+        });
+
+        Vector<T> result(total);
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            // cut the result, not the parts, into chunks, so one large part
+            // does not leave the other workers idle
+            T* out = result.append_uninitialized(total);
+            ics_detail::ChunkPlan(total, sizeof(T), ParallelOptions{0, pool}).run([&](size_t, size_t begin, size_t end) {
+                size_t p = 0;
+                while (p + 1 < parts.size() && offsets[p + 1] <= begin) ++p;
+                while (begin < end) {
+                    const Vector<T>& part = *parts[p];
+                    size_t first = begin - offsets[p];
+                    size_t count = std::min(end, offsets[p] + part.size()) - begin;
+                    if (count != 0) std::memcpy(out + begin, part.data() + first, count * sizeof(T));
+                    begin += count;
+                    ++p;
+                }
+            });
+        } else {
+            for (const Vector<T>* part : parts) {
+                for (const T& value : *part) {
+                    result.push_back(value);
+                }
+            }
+        }
+        return result;
+    }
+
+    // Empties every thread's Vector, keeping their capacity.
+    void clear() {
+        m_locals.for_each([](Vector<T>& part) {
+            part.clear();
+        });
+    }
+};
+
+#endif
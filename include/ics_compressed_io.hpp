@@ -0,0 +1,397 @@
+#ifndef ICS_COMPRESSED_IO_HPP
+#define ICS_COMPRESSED_IO_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include "ics_crc32c.hpp"
+#include "ics_file.hpp"
+#include "ics_parallel_algorithms.hpp"
+#include "ics_thread_pool.hpp"
+#include "ics_vector.hpp"
+#include "ics_vector_io.hpp"
+#include "vector_exception.hpp"
+
+// Block-compressed variant of the binary format for trivially copyable T.
+//
+// The BinaryHeader carries flag_compressed, the uncompressed block size in
+// `reserved` and the block count in `extra`. It is followed by one
+// CompressedBlock entry per block, the CRC32C of that table, and then the
+// stored bytes of every block in order. Each block is byte-shuffled (numeric
+// T wider than a byte) and LZ-compressed, or kept as is when compression does
+// not pay. Blocks are independent, so both directions spread them over a
+// ThreadPool (CompressionOptions::pool, or the pool argument when reading).
+
+struct CompressedBlock {
+    static constexpr uint8_t codec_stored = 0;
+    static constexpr uint8_t codec_lz = 1;
+    static constexpr uint8_t filter_shuffle = 1;
+
+    uint32_t stored_size;
+    uint32_t checksum;  // CRC32C of the stored bytes
+    uint8_t codec;
+    uint8_t filters;
+    uint16_t reserved;
+};
+
+static_assert(sizeof(CompressedBlock) == 12 && std::is_trivially_copyable_v<CompressedBlock>);
+
+struct CompressionOptions {
+    size_t block_size = size_t{1} << 20;  // uncompressed bytes per block
+    ThreadPool* pool = nullptr;           // nullptr uses ThreadPool::global()
+    bool shuffle = true;
+};
+
+namespace ics_detail {
+    // Byte shuffle: gathers byte j of every width-byte element into plane j,
+    // so the slowly changing high bytes of numbers form long runs.
+    inline void byte_shuffle(const unsigned char* in, size_t n, size_t width, unsigned char* out) noexcept {
+        size_t elements = n / width;
+        for (size_t i = 0; i < elements; ++i) {
+            for (size_t j = 0; j < width; ++j) {
+                out[j * elements + i] = in[i * width + j];
+            }
+        }
+    }
+
+    inline void byte_unshuffle(const unsigned char* in, size_t n, size_t width, unsigned char* out) noexcept {
+        size_t elements = n / width;
+        for (size_t i = 0; i < elements; ++i) {
+            for (size_t j = 0; j < width; ++j) {
+                out[i * width + j] = in[j * elements + i];
+            }
+        }
+    }
+
+    // LZ77 codec in the style of the LZ4 block format. Each sequence is a
+    // token (literal length << 4 | match length - 4), extra length bytes for
+    // nibbles of 15, the literals, a 16-bit little-endian match offset and
+    // extra match length bytes. The last sequence carries literals only.
+    inline constexpr size_t lz_min_match = 4;
+    inline constexpr size_t lz_max_offset = 65535;
+    inline constexpr int lz_hash_bits = 14;
+
+    inline constexpr size_t lz_bound(size_t n) noexcept {
+        return n + n / 255 + 16;
+    }
+
+    // Most bytes n compressed bytes can decode to: every extra match length
+    // byte adds at most 255.
+    inline constexpr size_t lz_max_output(size_t n) noexcept {
+        return (n + 1) * 255;
+    }
+
+    inline uint32_t lz_load32(const unsigned char* p) noexcept {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline unsigned char* lz_put_length(unsigned char* op, size_t extra) noexcept {
+        for (; extra >= 255; extra -= 255) {
+            *op++ = 255;
+        }
+        *op++ = static_cast<unsigned char>(extra);
+        return op;
+    }
+
+    inline unsigned char* lz_put_literals(unsigned char* op, const unsigned char* literals, size_t count,
+                                          size_t match_code) noexcept {
+        *op++ = static_cast<unsigned char>((std::min<size_t>(count, 15) << 4) | std::min<size_t>(match_code, 15));
+        if (count >= 15) {
+            op = lz_put_length(op, count - 15);
+        }
+        std::memcpy(op, literals, count);
+        return op + count;
+    }
+
+    // Compresses n bytes into out, which must hold lz_bound(n) bytes, and
+    // returns the compressed size.
+    inline size_t lz_compress(const unsigned char* in, size_t n, unsigned char* out) noexcept {
+        uint32_t table[size_t{1} << lz_hash_bits] = {};
+        unsigned char* op = out;
+        size_t anchor = 0;
+        size_t ip = 0;
+        while (ip + lz_min_match <= n) {
+            uint32_t sequence = lz_load32(in + ip);
+            uint32_t hash = (sequence * 2654435761u) >> (32 - lz_hash_bits);
+            size_t candidate = table[hash];
+            table[hash] = static_cast<uint32_t>(ip);
+            if (candidate >= ip || ip - candidate > lz_max_offset || lz_load32(in + candidate) != sequence) {
+                // step faster through data that keeps missing
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+            size_t length = lz_min_match;
+            while (ip + length < n && in[candidate + length] == in[ip + length]) {
+                ++length;
+            }
+            op = lz_put_literals(op, in + anchor, ip - anchor, length - lz_min_match);
+            size_t offset = ip - candidate;
+            *op++ = static_cast<unsigned char>(offset);
+            *op++ = static_cast<unsigned char>(offset >> 8);
+            if (length - lz_min_match >= 15) {
+                op = lz_put_length(op, length - lz_min_match - 15);
+            }
+            ip += length;
+            anchor = ip;
+        }
+        op = lz_put_literals(op, in + anchor, n - anchor, 0);
+        return static_cast<size_t>(op - out);
+    }
+
+    inline bool lz_get_length(const unsigned char*& ip, const unsigned char* end, size_t& length) noexcept {
+        unsigned char byte;
+        do {
+            if (ip == end) {
+                return false;
+            }
+            byte = *ip++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    // Decompresses exactly out_size bytes. Returns false on malformed input
+    // instead of reading or writing out of bounds.
+    inline bool lz_decompress(const unsigned char* in, size_t n, unsigned char* out, size_t out_size) noexcept {
+        const unsigned char* ip = in;
+        const unsigned char* in_end = in + n;
+        unsigned char* op = out;
+        unsigned char* out_end = out + out_size;
+        while (ip < in_end) {
+            unsigned token = *ip++;
+            size_t literals = token >> 4;
+            if (literals == 15 && !lz_get_length(ip, in_end, literals)) {
+                return false;
+            }
+            if (literals > static_cast<size_t>(in_end - ip) || literals > static_cast<size_t>(out_end - op)) {
+                return false;
+            }
+            std::memcpy(op, ip, literals);
+            ip += literals;
+            op += literals;
+            if (ip == in_end) {
+                break;
+            }
+
+            if (in_end - ip < 2) {
+                return false;
+            }
+            size_t offset = ip[0] | static_cast<size_t>(ip[1]) << 8;
+            ip += 2;
+            size_t length = token & 15;
+            if (length == 15 && !lz_get_length(ip, in_end, length)) {
+                return false;
+            }
+            length += lz_min_match;
+            if (offset == 0 || offset > static_cast<size_t>(op - out)
+                || length > static_cast<size_t>(out_end - op)) {
+                return false;
+            }
+            // Overlapping copy: the bytes behind op repeat with period offset,
+            // so each pass may copy everything written since match.
+            const unsigned char* match = op - offset;
+            while (length > 0) {
+                size_t chunk = std::min(static_cast<size_t>(op - match), length);
+                std::memcpy(op, match, chunk);
+                op += chunk;
+                length -= chunk;
+            }
+        }
+        return op == out_end;
+    }
+
+    // Runs work(i) for every block i on the pool, a run of blocks per task.
+    // Blocks are units of work, not elements in memory: passing a line-sized
+    // element keeps ChunkPlan from rounding runs up to many blocks.
+    template <typename F>
+    void for_each_block(size_t blocks, ThreadPool* pool, F work) {
+        ChunkPlan(blocks, cache_line_size, ParallelOptions{1, pool}).run([&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                work(i);
+            }
+        });
+    }
+
+    template <typename T>
+    constexpr bool shuffles_bytes() noexcept {
+        return std::is_arithmetic_v<T> && sizeof(T) > 1;
+    }
+}
+
+// Writes vec to fd in the block-compressed binary format.
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+void write_compressed(int fd, const Vector<T>& vec, const CompressionOptions& options = {}) {
+    size_t block_bytes = std::max<size_t>(1, options.block_size / sizeof(T)) * sizeof(T);
+    if (block_bytes > UINT32_MAX / 2) {
+        throw VectorException("compression block size is too large");
+    }
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(vec.data());
+    size_t total = vec.size() * sizeof(T);
+    size_t blocks = (total + block_bytes - 1) / block_bytes;
+    bool shuffle = options.shuffle && ics_detail::shuffles_bytes<T>();
+
+    // every block compresses into its own fixed slot of the arena
+    size_t slot_size = ics_detail::lz_bound(block_bytes);
+    Vector<unsigned char> arena;
+    unsigned char* slots = arena.append_uninitialized(blocks * slot_size);
+    Vector<CompressedBlock> table;
+    CompressedBlock* entries = table.append_uninitialized(blocks);
+
+    ics_detail::for_each_block(blocks, options.pool, [&](size_t i) {
+        size_t offset = i * block_bytes;
+        size_t length = std::min(block_bytes, total - offset);
+        const unsigned char* source = bytes + offset;
+        Vector<unsigned char> shuffled;
+        if (shuffle) {
+            ics_detail::byte_shuffle(source, length, sizeof(T), shuffled.append_uninitialized(length));
+            source = shuffled.data();
+        }
+        unsigned char* slot = slots + i * slot_size;
+        CompressedBlock entry{};
+        entry.filters = shuffle ? CompressedBlock::filter_shuffle : 0;
+        size_t packed = ics_detail::lz_compress(source, length, slot);
+        if (packed < length) {
+            entry.codec = CompressedBlock::codec_lz;
+            entry.stored_size = static_cast<uint32_t>(packed);
+        } else {
+            std::memcpy(slot, source, length);
+            entry.codec = CompressedBlock::codec_stored;
+            entry.stored_size = static_cast<uint32_t>(length);
+        }
+        entry.checksum = crc32c(slot, entry.stored_size);
+        entries[i] = entry;
+    });
+
+    BinaryHeader header = ics_detail::make_binary_header<T>(vec.size());
+    header.flags |= BinaryHeader::flag_compressed;
+    header.reserved = static_cast<uint32_t>(block_bytes);
+    header.extra = blocks;
+    uint32_t table_checksum = crc32c(entries, blocks * sizeof(CompressedBlock));
+
+    Vector<struct iovec> iov(blocks + 3);
+    iov.push_back({&header, sizeof(header)});
+    iov.push_back({entries, blocks * sizeof(CompressedBlock)});
+    iov.push_back({&table_checksum, sizeof(table_checksum)});
+    for (size_t i = 0; i < blocks; ++i) {
+        iov.push_back({slots + i * slot_size, entries[i].stored_size});
+    }
+    // writev takes at most IOV_MAX buffers per call
+    for (size_t first = 0; first < iov.size(); first += IOV_MAX) {
+        size_t count = std::min<size_t>(IOV_MAX, iov.size() - first);
+        ics_detail::write_all_v(fd, &iov[first], static_cast<int>(count));
+    }
+}
+
+// Reads a Vector written by write_compressed, verifying the block table and
+// every block checksum before any data is handed back. Uncompressed files
+// written by write_binary are accepted too.
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+Vector<T> read_compressed(int fd, ThreadPool* pool = nullptr) {
+    BinaryHeader header;
+    ics_detail::read_exact(fd, &header, sizeof(header));
+    size_t count = ics_detail::check_binary_header<T>(header);
+    Vector<T> result;
+    if (!(header.flags & BinaryHeader::flag_compressed)) {
+        ics_detail::read_raw_elements(fd, result, count);
+        return result;
+    }
+
+    size_t block_bytes = header.reserved;
+    size_t total = count * sizeof(T);
+    if (block_bytes == 0 || block_bytes % sizeof(T) != 0
+        || header.extra != (total + block_bytes - 1) / block_bytes) {
+        throw VectorException("corrupt compressed vector header");
+    }
+    size_t blocks = static_cast<size_t>(header.extra);
+
+    // every size below comes from the file: each is checked against what is
+    // left of it before anything is allocated
+    BinaryReader in(fd);
+    if (blocks > in.available() / sizeof(CompressedBlock)) {
+        throw VectorException("unexpected end of file: compressed vector block table exceeds the file");
+    }
+    Vector<CompressedBlock> table;
+    in.read_values(table, blocks);
+    const CompressedBlock* entries = table.data();
+    uint32_t table_checksum = in.read_value<uint32_t>();
+    if (crc32c(entries, blocks * sizeof(CompressedBlock)) != table_checksum) {
+        throw VectorException("compressed vector block table checksum mismatch");
+    }
+
+    Vector<size_t> offsets(blocks);
+    size_t stored = 0;
+    for (size_t i = 0; i < blocks; ++i) {
+        const CompressedBlock& entry = entries[i];
+        size_t length = std::min(block_bytes, total - i * block_bytes);
+        bool fits = false;
+        if (entry.codec == CompressedBlock::codec_stored) {
+            fits = entry.stored_size == length;
+        } else if (entry.codec == CompressedBlock::codec_lz) {
+            fits = length <= ics_detail::lz_max_output(entry.stored_size);
+        }
+        if (!fits || entry.stored_size > ics_detail::lz_bound(block_bytes)) {
+            throw VectorException("corrupt compressed vector block table");
+        }
+        offsets.push_back(stored);
+        stored += entry.stored_size;
+    }
+    if (stored > in.available()) {
+        throw VectorException("unexpected end of file: compressed vector blocks exceed the file");
+    }
+    Vector<unsigned char> payload;
+    in.read_values(payload, stored);
+    in.finish();
+
+    unsigned char* out = reinterpret_cast<unsigned char*>(result.append_uninitialized(count));
+    ics_detail::for_each_block(blocks, pool, [&](size_t i) {
+        const CompressedBlock& entry = entries[i];
+        const unsigned char* source = payload.data() + offsets[i];
+        if (crc32c(source, entry.stored_size) != entry.checksum) {
+            throw VectorException("compressed vector block " + std::to_string(i) + " checksum mismatch");
+        }
+        size_t offset = i * block_bytes;
+        size_t length = std::min(block_bytes, total - offset);
+        bool shuffled = entry.filters & CompressedBlock::filter_shuffle;
+
+        Vector<unsigned char> scratch;
+        unsigned char* target = shuffled ? scratch.append_uninitialized(length) : out + offset;
+        bool decoded = false;
+        if (entry.codec == CompressedBlock::codec_lz) {
+            decoded = ics_detail::lz_decompress(source, entry.stored_size, target, length);
+        } else if (entry.codec == CompressedBlock::codec_stored && entry.stored_size == length) {
+            std::memcpy(target, source, length);
+            decoded = true;
+        }
+        if (!decoded) {
+            throw VectorException("corrupt compressed vector block " + std::to_string(i));
+        }
+        if (shuffled) {
+            ics_detail::byte_unshuffle(target, length, sizeof(T), out + offset);
+        }
+    });
+    return result;
+}
+
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+void save_compressed(const Vector<T>& vec, const std::string& path, const CompressionOptions& options = {}) {
+    ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_WRONLY | O_CREAT | O_TRUNC);
+    write_compressed(fd.get(), vec, options);
+}
+
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+Vector<T> load_compressed(const std::string& path, ThreadPool* pool = nullptr) {
+    ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_RDONLY);
+    return read_compressed<T>(fd.get(), pool);
+}
+
+#endif
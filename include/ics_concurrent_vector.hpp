@@ -0,0 +1,292 @@
+#ifndef ICS_CONCURRENT_VECTOR_HPP
+#define ICS_CONCURRENT_VECTOR_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "ics_cache_line.hpp"
+#include "ics_vector.hpp"
+#include "vector_exception.hpp"
+
+// Grow-only vector that any number of threads may append to without a lock.
+// An append reserves its index with one fetch_add on the size, constructs
+// the element in place and then sets that slot's published flag. Storage is
+// a list of segments doubling in size, allocated once on first use and never
+// moved, so references to elements stay valid while others append.
+//
+// size() counts reserved slots, some of which may still be under
+// construction; read an element concurrently only after published(index),
+// or once the appending threads have been joined.
+
+template <typename T>
+class ConcurrentVector {
+private:
+    using Flag = std::atomic<uint8_t>;
+    static constexpr size_t max_segments = 48;
+
+    unsigned m_first_shift;  // segment s holds 1 << (m_first_shift + s) slots
+    alignas(ics_detail::cache_line_size) std::atomic<size_t> m_size;
+    alignas(ics_detail::cache_line_size) std::atomic<T*> m_segments[max_segments];
+
+    size_t segment_capacity(size_t segment) const noexcept {
+        return size_t{1} << (m_first_shift + segment);
+    }
+
+    size_t segment_base(size_t segment) const noexcept {
+        return ((size_t{1} << segment) - 1) << m_first_shift;
+    }
+
+    size_t segment_of(size_t index) const noexcept {
+        return static_cast<size_t>(std::bit_width((index >> m_first_shift) + 1)) - 1;
+    }
+
+    // The published flags follow a segment's elements in the same block.
+    Flag* flags(T* segment_data, size_t segment) const noexcept {
+        return reinterpret_cast<Flag*>(reinterpret_cast<char*>(segment_data) + segment_capacity(segment) * sizeof(T));
+    }
+
+    // Marks a segment one thread is allocating. Never dereferenced.
+    T* allocating() const noexcept {
+        return reinterpret_cast<T*>(const_cast<std::atomic<size_t>*>(&m_size));
+    }
+
+    // One thread allocates each segment: the one that swaps nullptr for the
+    // allocating() marker. Appenders reach a new segment together, so the
+    // others wait for it instead of each allocating a full-size copy.
+    T* ensure_segment(size_t segment) {
+        std::atomic<T*>& slot = m_segments[segment];
+        T* current = slot.load(std::memory_order_acquire);
+        while (current == nullptr || current == allocating()) {
+            if (current == allocating()) {
+                slot.wait(current, std::memory_order_acquire);
+                current = slot.load(std::memory_order_acquire);
+                continue;
+            }
+            if (!slot.compare_exchange_weak(current, allocating(), std::memory_order_acquire)) {
+                continue;
+            }
+            size_t count = segment_capacity(segment);
+            T* fresh;
+            try {
+                fresh = static_cast<T*>(::operator new(count * (sizeof(T) + sizeof(Flag)), std::align_val_t{alignof(T)}));
+            } catch (...) {
+                // let a waiter try again
+                slot.store(nullptr, std::memory_order_release);
+                slot.notify_all();
+                throw;
+            }
+            new (flags(fresh, segment)) Flag[count]();
+            slot.store(fresh, std::memory_order_release);
+            slot.notify_all();
+            return fresh;
+        }
+        return current;
+    }
+
+    template <typename... Args>
+    void construct(size_t index, Args&&... args) {
+        size_t segment = segment_of(index);
+        T* segment_data = ensure_segment(segment);
+        size_t offset = index - segment_base(segment);
+        new (segment_data + offset) T(std::forward<Args>(args)...);
+        flags(segment_data, segment)[offset].store(1, std::memory_order_release);
+    }
+
+    void destroy_elements() noexcept {
+        for (size_t segment = 0; segment < max_segments; ++segment) {
+            T* segment_data = m_segments[segment].load(std::memory_order_acquire);
+            if (segment_data == nullptr) {
+                continue;
+            }
+            Flag* segment_flags = flags(segment_data, segment);
+            for (size_t i = 0; i < segment_capacity(segment); ++i) {
+                if (segment_flags[i].load(std::memory_order_relaxed) != 0) {
+                    segment_data[i].~T();
+                    segment_flags[i].store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+public:
+    class Iterator {
+    private:
+        ConcurrentVector* m_vector;
+        size_t m_index;
+
+    public:
+        Iterator(ConcurrentVector* vector, size_t index) noexcept : m_vector(vector), m_index(index) {}
+
+        T& operator*() const noexcept {
+            return (*m_vector)[m_index];
+        }
+
+        Iterator& operator++() noexcept {
+            ++m_index;
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const noexcept {
+            return m_index == other.m_index;
+        }
+    };
+
+    // Slots [first(), first() + size()) reserved by one grow_by call.
+    class Range {
+    private:
+        ConcurrentVector* m_vector;
+        size_t m_first;
+        size_t m_last;
+
+    public:
+        Range(ConcurrentVector* vector, size_t first, size_t last) noexcept
+            : m_vector(vector), m_first(first), m_last(last) {}
+
+        size_t first() const noexcept {
+            return m_first;
+        }
+
+        size_t size() const noexcept {
+            return m_last - m_first;
+        }
+
+        T& operator[](size_t offset) const noexcept {
+            return (*m_vector)[m_first + offset];
+        }
+
+        Iterator begin() const noexcept {
+            return Iterator(m_vector, m_first);
+        }
+
+        Iterator end() const noexcept {
+            return Iterator(m_vector, m_last);
+        }
+    };
+
+    // first_segment is rounded up to a power of two.
+    explicit ConcurrentVector(size_t first_segment = 64)
+        : m_first_shift(static_cast<unsigned>(std::bit_width((first_segment > 1 ? first_segment : 2) - 1))), m_size(0) {
+        for (std::atomic<T*>& segment : m_segments) {
+            segment.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    ~ConcurrentVector() {
+        destroy_elements();
+        for (std::atomic<T*>& segment : m_segments) {
+            T* segment_data = segment.load(std::memory_order_relaxed);
+            if (segment_data != nullptr) {
+                ::operator delete(segment_data, std::align_val_t{alignof(T)});
+            }
+        }
+    }
+
+    // Returns the index the value was stored at.
+    size_t push_back(const T& value) {
+        return emplace_back(value);
+    }
+
+    size_t push_back(T&& value) {
+        return emplace_back(std::move(value));
+    }
+
+    template <typename... Args>
+    size_t emplace_back(Args&&... args) {
+        size_t index = m_size.fetch_add(1, std::memory_order_relaxed);
+        construct(index, std::forward<Args>(args)...);
+        return index;
+    }
+
+    // Appends count copies of value at consecutive indices.
+    Range grow_by(size_t count, const T& value = T()) {
+        size_t first = m_size.fetch_add(count, std::memory_order_relaxed);
+        for (size_t i = first; i < first + count; ++i) {
+            construct(i, value);
+        }
+        return Range(this, first, first + count);
+    }
+
+    // Allocates the segments covering the first n slots up front.
+    void reserve(size_t n) {
+        if (n == 0) {
+            return;
+        }
+        for (size_t segment = 0; segment <= segment_of(n - 1); ++segment) {
+            ensure_segment(segment);
+        }
+    }
+
+    size_t size() const noexcept {
+        return m_size.load(std::memory_order_acquire);
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    // Whether the element at index is fully constructed and safe to read.
+    bool published(size_t index) const noexcept {
+        if (index >= size()) {
+            return false;
+        }
+        size_t segment = segment_of(index);
+        T* segment_data = m_segments[segment].load(std::memory_order_acquire);
+        return segment_data != nullptr && segment_data != allocating() &&
+               flags(segment_data, segment)[index - segment_base(segment)].load(std::memory_order_acquire) != 0;
+    }
+
+    T& operator[](size_t index) noexcept {
+        size_t segment = segment_of(index);
+        return m_segments[segment].load(std::memory_order_acquire)[index - segment_base(segment)];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        size_t segment = segment_of(index);
+        return m_segments[segment].load(std::memory_order_acquire)[index - segment_base(segment)];
+    }
+
+    T& at(size_t index) {
+        if (!published(index)) {
+            throw VectorException("out of bounds");
+        }
+        return (*this)[index];
+    }
+
+    const T& at(size_t index) const {
+        if (!published(index)) {
+            throw VectorException("out of bounds");
+        }
+        return (*this)[index];
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, size());
+    }
+
+    // Not safe against concurrent appends; keeps the segments.
+    void clear() noexcept {
+        destroy_elements();
+        m_size.store(0, std::memory_order_release);
+    }
+
+    Vector<T> to_vector() const {
+        size_t n = size();
+        Vector<T> result(n);
+        for (size_t i = 0; i < n; ++i) {
+            result.push_back((*this)[i]);
+        }
+        return result;
+    }
+};
+
+#endif
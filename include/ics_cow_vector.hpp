@@ -0,0 +1,292 @@
+#ifndef ICS_COW_VECTOR_HPP
+#define ICS_COW_VECTOR_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include "ics_vector.hpp"
+#include "vector_exception.hpp"
+
+// Chunked copy-on-write vector. Elements live in fixed-capacity chunks held
+// by shared_ptr in a chunk table, itself held by shared_ptr. snapshot() only
+// bumps the table's reference count; the writer then copies the table on its
+// next write and a chunk the first time it changes one that a snapshot still
+// shares. Snapshots never change, so any number of threads may read them
+// without synchronization.
+//
+// The CowVector itself, including snapshot(), belongs to a single writer
+// thread; snapshots may be copied to and destroyed on any thread.
+
+namespace ics_detail {
+    // Read side shared by CowVector and CowSnapshot.
+    template <typename T>
+    class CowChunks {
+    protected:
+        using Chunk = Vector<T>;
+        using Table = Vector<std::shared_ptr<Chunk>>;
+
+        std::shared_ptr<Table> m_table;
+        size_t m_size;
+        unsigned m_chunk_shift;
+
+        CowChunks(std::shared_ptr<Table> table, size_t size, unsigned chunk_shift) noexcept
+            : m_table(std::move(table)), m_size(size), m_chunk_shift(chunk_shift) {}
+
+        size_t chunk_mask() const noexcept {
+            return (size_t{1} << m_chunk_shift) - 1;
+        }
+
+        const Chunk& chunk(size_t index) const noexcept {
+            const Table& table = *m_table;
+            return *table[index >> m_chunk_shift];
+        }
+
+    public:
+        // Walks the elements chunk by chunk, caching the current chunk.
+        class ConstIterator {
+        private:
+            const Table* m_table;
+            mutable const T* m_chunk;
+            size_t m_index;
+            unsigned m_shift;
+
+        public:
+            ConstIterator(const Table* table, size_t index, unsigned shift) noexcept
+                : m_table(table), m_chunk(nullptr), m_index(index), m_shift(shift) {}
+
+            const T& operator*() const noexcept {
+                if (m_chunk == nullptr) {
+                    m_chunk = (*m_table)[m_index >> m_shift]->data();
+                }
+                return m_chunk[m_index & ((size_t{1} << m_shift) - 1)];
+            }
+
+            ConstIterator& operator++() noexcept {
+                ++m_index;
+                if ((m_index & ((size_t{1} << m_shift) - 1)) == 0) {
+                    m_chunk = nullptr;
+                }
+                return *this;
+            }
+
+            bool operator==(const ConstIterator& other) const noexcept {
+                return m_index == other.m_index;
+            }
+        };
+
+        size_t size() const noexcept {
+            return m_size;
+        }
+
+        bool empty() const noexcept {
+            return m_size == 0;
+        }
+
+        size_t chunk_size() const noexcept {
+            return size_t{1} << m_chunk_shift;
+        }
+
+        const T& operator[](size_t index) const noexcept {
+            return chunk(index)[index & chunk_mask()];
+        }
+
+        const T& at(size_t index) const {
+            if (index >= m_size) {
+                throw VectorException("out of bounds");
+            }
+            return (*this)[index];
+        }
+
+        ConstIterator begin() const noexcept {
+            return ConstIterator(m_table.get(), 0, m_chunk_shift);
+        }
+
+        ConstIterator end() const noexcept {
+            return ConstIterator(m_table.get(), m_size, m_chunk_shift);
+        }
+
+        // Calls f(const T* first, size_t count) for each chunk in order.
+        template <typename F>
+        void for_each_chunk(F&& f) const {
+            for (size_t first = 0; first < m_size; first += chunk_size()) {
+                size_t count = m_size - first < chunk_size() ? m_size - first : chunk_size();
+                f(chunk(first).data(), count);
+            }
+        }
+
+        bool operator==(const Vector<T>& other) const {
+            if (m_size != other.size()) {
+                return false;
+            }
+            size_t i = 0;
+            for (const T& value : *this) {
+                if (!(value == other[i++])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        Vector<T> to_vector() const {
+            Vector<T> result(m_size);
+            for_each_chunk([&](const T* first, size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    result.push_back(first[i]);
+                }
+            });
+            return result;
+        }
+    };
+}
+
+// Immutable point-in-time view returned by CowVector::snapshot().
+template <typename T>
+class CowSnapshot : public ics_detail::CowChunks<T> {
+private:
+    using Base = ics_detail::CowChunks<T>;
+
+    template <typename>
+    friend class CowVector;
+
+    CowSnapshot(std::shared_ptr<typename Base::Table> table, size_t size, unsigned chunk_shift) noexcept
+        : Base(std::move(table), size, chunk_shift) {}
+
+public:
+    CowSnapshot() noexcept : Base(nullptr, 0, 0) {}
+};
+
+template <typename T>
+class CowVector : public ics_detail::CowChunks<T> {
+private:
+    using Base = ics_detail::CowChunks<T>;
+    using typename Base::Chunk;
+    using typename Base::Table;
+    using Base::m_chunk_shift;
+    using Base::m_size;
+    using Base::m_table;
+
+    // Whether the writer holds the only reference. The acquire fence pairs
+    // with the release decrement of a snapshot released on another thread,
+    // so the writer does not overwrite data that snapshot was still reading.
+    template <typename U>
+    static bool unique(const std::shared_ptr<U>& pointer) noexcept {
+        if (pointer.use_count() != 1) {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return true;
+    }
+
+    Table& writable_table() {
+        if (!unique(m_table)) {
+            m_table = std::make_shared<Table>(*m_table);
+        }
+        return *m_table;
+    }
+
+    Chunk& writable_chunk(size_t chunk_index) {
+        Table& table = writable_table();
+        if (!unique(table[chunk_index])) {
+            table[chunk_index] = std::make_shared<Chunk>(*table[chunk_index]);
+        }
+        return *table[chunk_index];
+    }
+
+public:
+    // chunk_size is rounded up to a power of two.
+    explicit CowVector(size_t chunk_size = 1024)
+        : Base(std::make_shared<Table>(), 0,
+               static_cast<unsigned>(std::bit_width((chunk_size > 1 ? chunk_size : 2) - 1))) {}
+
+    CowVector(const CowVector&) = delete;
+    CowVector& operator=(const CowVector&) = delete;
+
+    // The source is left empty with a table of its own, so it stays usable.
+    // Not noexcept: that fresh table is allocated.
+    CowVector(CowVector&& other)
+        : Base(std::make_shared<Table>(), 0, other.m_chunk_shift) {
+        std::swap(m_table, other.m_table);
+        std::swap(m_size, other.m_size);
+    }
+
+    CowVector& operator=(CowVector&& other) {
+        if (this != &other) {
+            std::shared_ptr<Table> empty = std::make_shared<Table>();
+            m_table = std::exchange(other.m_table, std::move(empty));
+            m_size = std::exchange(other.m_size, 0);
+            m_chunk_shift = other.m_chunk_shift;
+        }
+        return *this;
+    }
+
+    // O(1): shares the current chunk table.
+    CowSnapshot<T> snapshot() const noexcept {
+        return CowSnapshot<T>(m_table, m_size, m_chunk_shift);
+    }
+
+    void push_back(const T& value) {
+        size_t chunk_index = m_size >> m_chunk_shift;
+        Table& table = writable_table();
+        if (chunk_index == table.size()) {
+            table.push_back(std::make_shared<Chunk>(this->chunk_size()));
+        }
+        writable_chunk(chunk_index).push_back(value);
+        ++m_size;
+    }
+
+    void pop_back() {
+        if (m_size == 0) {
+            throw VectorException("popping from empty");
+        }
+        size_t chunk_index = (m_size - 1) >> m_chunk_shift;
+        Chunk& chunk = writable_chunk(chunk_index);
+        chunk.pop_back();
+        --m_size;
+        if (chunk.empty()) {
+            m_table->pop_back();
+        }
+    }
+
+    void set(size_t index, const T& value) {
+        at(index) = value;
+    }
+
+    // Writable access; copies the element's chunk first if a snapshot
+    // shares it.
+    T& operator[](size_t index) {
+        return writable_chunk(index >> m_chunk_shift)[index & this->chunk_mask()];
+    }
+
+    using Base::operator[];
+
+    T& at(size_t index) {
+        if (index >= m_size) {
+            throw VectorException("out of bounds");
+        }
+        return (*this)[index];
+    }
+
+    using Base::at;
+
+    void clear() {
+        m_table = std::make_shared<Table>();
+        m_size = 0;
+    }
+
+    // Chunks this vector shares with at least one snapshot.
+    size_t shared_chunks() const noexcept {
+        const Table& table = *m_table;
+        if (m_table.use_count() > 1) {
+            return table.size();
+        }
+        size_t shared = 0;
+        for (size_t i = 0; i < table.size(); ++i) {
+            shared += table[i].use_count() > 1;
+        }
+        return shared;
+    }
+};
+
+#endif
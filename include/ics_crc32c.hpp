@@ -0,0 +1,78 @@
+#ifndef ICS_CRC32C_HPP
+#define ICS_CRC32C_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ICS_CRC32C_SSE42 1
+#include <nmmintrin.h>
+#endif
+
+// CRC32C (Castagnoli), the checksum used by iSCSI, ext4 and most storage
+// formats. x86-64 CPUs with SSE4.2 compute it in hardware; others fall back to
+// a table.
+namespace ics_detail {
+    inline constexpr uint32_t crc32c_polynomial = 0x82F63B78;  // reflected
+
+    inline constexpr std::array<uint32_t, 256> crc32c_table = [] {
+        std::array<uint32_t, 256> table{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ (crc & 1 ? crc32c_polynomial : 0);
+            }
+            table[i] = crc;
+        }
+        return table;
+    }();
+
+    // Raw CRC update without the pre- and post-inversion.
+    inline uint32_t crc32c_software(uint32_t crc, const unsigned char* p, size_t n) noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            crc = crc32c_table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+#if defined(ICS_CRC32C_SSE42)
+    __attribute__((target("sse4.2"))) inline uint32_t crc32c_sse42(uint32_t crc, const unsigned char* p,
+                                                                   size_t n) noexcept {
+        uint64_t wide = crc;
+        for (; n >= 8; p += 8, n -= 8) {
+            uint64_t word;
+            std::memcpy(&word, p, sizeof(word));
+            wide = _mm_crc32_u64(wide, word);
+        }
+        crc = static_cast<uint32_t>(wide);
+        for (; n > 0; ++p, --n) {
+            crc = _mm_crc32_u8(crc, *p);
+        }
+        return crc;
+    }
+
+    inline bool crc32c_hardware() noexcept {
+        static const bool supported = __builtin_cpu_supports("sse4.2");
+        return supported;
+    }
+#else
+    inline bool crc32c_hardware() noexcept {
+        return false;
+    }
+#endif
+}
+
+// CRC32C of n bytes. Pass a previous result as crc to checksum data in pieces.
+inline uint32_t crc32c(const void* data, size_t n, uint32_t crc = 0) noexcept {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+#if defined(ICS_CRC32C_SSE42)
+    if (ics_detail::crc32c_hardware()) {
+        return ~ics_detail::crc32c_sse42(~crc, p, n);
+    }
+#endif
+    return ~ics_detail::crc32c_software(~crc, p, n);
+}
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef ICS_DICT_VECTOR_HPP
+#define ICS_DICT_VECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <utility>
+#include "ics_vector.hpp"
+#include "vector_exception.hpp"
+
+// Dictionary-encoded vector for columns with few distinct values. Each distinct
+// value is stored once in the dictionary and every element is a small integer
+// code into it. Codes start at 8 bits and are widened to 16 and 32 bits when the
+// dictionary outgrows the current width.
+template <typename T, typename Hash = std::hash<T>>
+class DictVector {
+private:
+    static constexpr uint32_t empty_slot = UINT32_MAX;
+
+    Vector<T> m_values;
+    Vector<uint32_t> m_index;
+    Vector<uint8_t> m_codes8;
+    Vector<uint16_t> m_codes16;
+    Vector<uint32_t> m_codes32;
+    size_t m_code_width;
+    Hash m_hash;
+
+    size_t slot_for(const T& value) const {
+        size_t mask = m_index.size() - 1;
+        size_t slot = m_hash(value) & mask;
+        while (m_index[slot] != empty_slot && !(m_values[m_index[slot]] == value)) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void rehash(size_t slots) {
+        Vector<uint32_t> index(slots);
+        for (size_t i = 0; i < slots; ++i) {
+            index.push_back(empty_slot);
+        }
+        m_index = std::move(index);
+        for (uint32_t code = 0; code < m_values.size(); ++code) {
+            m_index[slot_for(m_values[code])] = code;
+        }
+    }
+
+    template <typename From, typename To>
+    static void widen(Vector<From>& from, Vector<To>& to) {
+        to.resize(from.capacity() > 0 ? from.capacity() : 1);
+        for (size_t i = 0; i < from.size(); ++i) {
+            to.push_back(static_cast<To>(from[i]));
+        }
+        from = Vector<From>();
+    }
+
+    uint32_t intern(const T& value) {
+        if (m_index.size() == 0) {
+            rehash(16);
+        }
+        size_t slot = slot_for(value);
+        if (m_index[slot] != empty_slot) {
+            return m_index[slot];
+        }
+
+        if (m_values.size() == empty_slot) {
+            throw VectorException("dictionary full");
+        }
+        uint32_t code = static_cast<uint32_t>(m_values.size());
+        m_values.push_back(value);
+        m_index[slot] = code;
+        // keep the load factor at or below one half so probes stay short
+        if (m_values.size() * 2 > m_index.size()) {
+            rehash(m_index.size() * 2);
+        }
+
+        if (m_code_width == 1 && code > UINT8_MAX) {
+            widen(m_codes8, m_codes16);
+            m_code_width = 2;
+        } else if (m_code_width == 2 && code > UINT16_MAX) {
+            widen(m_codes16, m_codes32);
+            m_code_width = 4;
+        }
+        return code;
+    }
+
+    template <typename Code, typename F>
+    static void scan_codes(const Vector<Code>& codes, uint32_t code, F&& on_match) {
+        const Code* first = codes.data();
+        Code needle = static_cast<Code>(code);
+        for (size_t i = 0; i < codes.size(); ++i) {
+            if (first[i] == needle) {
+                on_match(i);
+            }
+        }
+    }
+
+    template <typename Code>
+    static size_t count_codes(const Vector<Code>& codes, uint32_t code) noexcept {
+        const Code* first = codes.data();
+        Code needle = static_cast<Code>(code);
+        size_t count = 0;
+        for (size_t i = 0; i < codes.size(); ++i) {
+            count += first[i] == needle;
+        }
+        return count;
+    }
+
+public:
+    DictVector() noexcept : m_code_width(1) {}
+
+    explicit DictVector(const Vector<T>& values) : m_code_width(1) {
+        m_codes8.resize(values.size());
+        for (const T& value : values) {
+            push_back(value);
+        }
+    }
+
+    void push_back(const T& value) {
+        uint32_t code = intern(value);
+        switch (m_code_width) {
+        case 1:
+            m_codes8.push_back(static_cast<uint8_t>(code));
+            break;
+        case 2:
+            m_codes16.push_back(static_cast<uint16_t>(code));
+            break;
+        default:
+            m_codes32.push_back(code);
+            break;
+        }
+    }
+
+    uint32_t code(size_t index) const noexcept {
+        switch (m_code_width) {
+        case 1:
+            return m_codes8[index];
+        case 2:
+            return m_codes16[index];
+        default:
+            return m_codes32[index];
+        }
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return m_values[code(index)];
+    }
+
+    const T& at(size_t index) const {
+        if (index >= size()) {
+            throw VectorException("out of bounds");
+        }
+        return (*this)[index];
+    }
+
+    size_t size() const noexcept {
+        switch (m_code_width) {
+        case 1:
+            return m_codes8.size();
+        case 2:
+            return m_codes16.size();
+        default:
+            return m_codes32.size();
+        }
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    // Number of distinct values.
+    size_t cardinality() const noexcept {
+        return m_values.size();
+    }
+
+    // Bytes per code: 1, 2 or 4.
+    size_t code_width() const noexcept {
+        return m_code_width;
+    }
+
+    const Vector<T>& dictionary() const noexcept {
+        return m_values;
+    }
+
+    std::optional<uint32_t> find_code(const T& value) const {
+        if (m_index.size() == 0) {
+            return std::nullopt;
+        }
+        uint32_t code = m_index[slot_for(value)];
+        if (code == empty_slot) {
+            return std::nullopt;
+        }
+        return code;
+    }
+
+    // Equality filters resolve the value to its code once and then compare
+    // codes only, never touching the dictionary values.
+    size_t count_equal(const T& value) const {
+        std::optional<uint32_t> code = find_code(value);
+        if (!code) {
+            return 0;
+        }
+        switch (m_code_width) {
+        case 1:
+            return count_codes(m_codes8, *code);
+        case 2:
+            return count_codes(m_codes16, *code);
+        default:
+            return count_codes(m_codes32, *code);
+        }
+    }
+
+    Vector<size_t> filter_equal(const T& value) const {
+        Vector<size_t> positions;
+        std::optional<uint32_t> code = find_code(value);
+        if (!code) {
+            return positions;
+        }
+        auto append = [&positions](size_t i) { positions.push_back(i); };
+        switch (m_code_width) {
+        case 1:
+            scan_codes(m_codes8, *code, append);
+            break;
+        case 2:
+            scan_codes(m_codes16, *code, append);
+            break;
+        default:
+            scan_codes(m_codes32, *code, append);
+            break;
+        }
+        return positions;
+    }
+
+    Vector<T> to_vector() const {
+        Vector<T> result(size());
+        for (size_t i = 0; i < size(); ++i) {
+            result.push_back((*this)[i]);
+        }
+        return result;
+    }
+
+    // Approximate heap footprint of the codes, dictionary slots and hash index.
+    size_t memory_bytes() const noexcept {
+        return m_values.capacity() * sizeof(T)
+            + m_index.capacity() * sizeof(uint32_t)
+            + m_codes8.capacity() * sizeof(uint8_t)
+            + m_codes16.capacity() * sizeof(uint16_t)
+            + m_codes32.capacity() * sizeof(uint32_t);
+    }
+
+    void clear() noexcept {
+        m_values.clear();
+        m_index = Vector<uint32_t>();
+        m_codes8.clear();
+        m_codes16 = Vector<uint16_t>();
+        m_codes32 = Vector<uint32_t>();
+        m_code_width = 1;
+    }
+
+    bool operator==(const DictVector& other) const {
+        if (size() != other.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < size(); ++i) {
+            if (!((*this)[i] == other[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const DictVector& other) const {
+        return !(*this == other);
+    }
+};
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef ICS_FILE_HPP
+#define ICS_FILE_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "vector_exception.hpp"
+
+// Thin POSIX helpers shared by the file-format headers. Failures are reported
+// as VectorException.
+namespace ics_detail {
+    // Largest single read/write; Linux transfers at most ~2GB per call anyway.
+    inline constexpr size_t max_io_chunk = size_t{1} << 30;
+
+    class FileDescriptor {
+    private:
+        int m_fd;
+
+    public:
+        explicit FileDescriptor(int fd = -1) noexcept : m_fd(fd) {}
+
+        FileDescriptor(const FileDescriptor&) = delete;
+        FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+        FileDescriptor(FileDescriptor&& other) noexcept : m_fd(other.m_fd) {
+            other.m_fd = -1;
+        }
+
+        FileDescriptor& operator=(FileDescriptor&& other) noexcept {
+            if (this != &other) {
+                if (m_fd >= 0) {
+                    ::close(m_fd);
+                }
+                m_fd = other.m_fd;
+                other.m_fd = -1;
+            }
+            return *this;
+        }
+
+        ~FileDescriptor() noexcept {
+            if (m_fd >= 0) {
+                ::close(m_fd);
+            }
+        }
+
+        int get() const noexcept {
+            return m_fd;
+        }
+    };
+
+    inline FileDescriptor open_file(const std::string& path, int flags, mode_t mode = 0644) {
+        int fd = ::open(path.c_str(), flags | O_CLOEXEC, mode);
+        if (fd < 0) {
+            throw VectorException("cannot open " + path);
+        }
+        return FileDescriptor(fd);
+    }
+
+    inline size_t file_size(int fd) {
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            throw VectorException("cannot stat file");
+        }
+        return static_cast<size_t>(info.st_size);
+    }
+
+    // Bytes from the current position of fd to the end of the file, or
+    // SIZE_MAX when fd is not a regular file and its length is unknown.
+    inline size_t remaining_bytes(int fd) {
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            throw VectorException("cannot stat file");
+        }
+        off_t position = S_ISREG(info.st_mode) ? ::lseek(fd, 0, SEEK_CUR) : -1;
+        if (position < 0) {
+            return SIZE_MAX;
+        }
+        return position < info.st_size ? static_cast<size_t>(info.st_size - position) : 0;
+    }
+
+    // Reads exactly n bytes, retrying short reads.
+    inline void read_exact(int fd, void* buffer, size_t n) {
+        char* out = static_cast<char*>(buffer);
+        while (n > 0) {
+            ssize_t got = ::read(fd, out, n < max_io_chunk ? n : max_io_chunk);
+            if (got < 0 && errno == EINTR) {
+                continue;
+            }
+            if (got <= 0) {
+                throw VectorException(got == 0 ? "unexpected end of file" : "read failed");
+            }
+            out += got;
+            n -= static_cast<size_t>(got);
+        }
+    }
+
+    // Writes all n bytes, retrying short writes.
+    inline void write_all(int fd, const void* buffer, size_t n) {
+        const char* in = static_cast<const char*>(buffer);
+        while (n > 0) {
+            ssize_t put = ::write(fd, in, n < max_io_chunk ? n : max_io_chunk);
+            if (put < 0 && errno == EINTR) {
+                continue;
+            }
+            if (put < 0) {
+                throw VectorException("write failed");
+            }
+            in += put;
+            n -= static_cast<size_t>(put);
+        }
+    }
+
+    // Gathers all iov buffers into one writev call where the kernel allows,
+    // continuing after short writes. iov is consumed in the process.
+    inline void write_all_v(int fd, struct iovec* iov, int count) {
+        while (count > 0) {
+            if (iov->iov_len == 0) {
+                ++iov;
+                --count;
+                continue;
+            }
+            ssize_t put = ::writev(fd, iov, count);
+            if (put < 0 && errno == EINTR) {
+                continue;
+            }
+            if (put < 0) {
+                throw VectorException("write failed");
+            }
+            size_t done = static_cast<size_t>(put);
+            while (count > 0 && done >= iov->iov_len) {
+                done -= iov->iov_len;
+                ++iov;
+                --count;
+            }
+            if (count > 0) {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + done;
+                iov->iov_len -= done;
+            }
+        }
+    }
+
+    // Read-only shared mapping of a whole file; pages come from the page
+    // cache, so every process mapping the same file shares them.
+    class MappedFile {
+    private:
+        void* m_base;
+        size_t m_length;
+
+    public:
+        MappedFile() noexcept : m_base(nullptr), m_length(0) {}
+
+        explicit MappedFile(const std::string& path) : MappedFile() {
+            FileDescriptor fd = open_file(path, O_RDONLY);
+            m_length = file_size(fd.get());
+            if (m_length == 0) {
+                return;
+            }
+            m_base = ::mmap(nullptr, m_length, PROT_READ, MAP_SHARED, fd.get(), 0);
+            if (m_base == MAP_FAILED) {
+                m_base = nullptr;
+                throw VectorException("cannot map " + path);
+            }
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept : m_base(other.m_base), m_length(other.m_length) {
+            other.m_base = nullptr;
+            other.m_length = 0;
+        }
+
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                if (m_base != nullptr) {
+                    ::munmap(m_base, m_length);
+                }
+                m_base = other.m_base;
+                m_length = other.m_length;
+                other.m_base = nullptr;
+                other.m_length = 0;
+            }
+            return *this;
+        }
+
+        ~MappedFile() noexcept {
+            if (m_base != nullptr) {
+                ::munmap(m_base, m_length);
+            }
+        }
+
+        const char* data() const noexcept {
+            return static_cast<const char*>(m_base);
+        }
+
+        size_t size() const noexcept {
+            return m_length;
+        }
+
+        // Forwards an madvise hint (MADV_SEQUENTIAL, MADV_RANDOM, ...) for the
+        // byte range [offset, offset + length), widened to page boundaries.
+        void advise(size_t offset, size_t length, int advice) const noexcept {
+            if (m_base == nullptr || length == 0) {
+                return;
+            }
+            size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            size_t start = offset / page * page;
+            ::madvise(static_cast<char*>(m_base) + start, offset + length - start, advice);
+        }
+    };
+}
+
+#endif
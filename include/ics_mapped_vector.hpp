@@ -0,0 +1,146 @@
+#ifndef ICS_MAPPED_VECTOR_HPP
+#define ICS_MAPPED_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include "ics_file.hpp"
+#include "ics_vector.hpp"
+#include "ics_vector_io.hpp"
+#include "vector_exception.hpp"
+
+// Read-only view of a file in the binary Vector format (see save_binary).
+// Elements are served straight from a shared mapping of the file, so nothing
+// is copied onto the heap and every process viewing the same file reads the
+// same page-cache pages.
+
+enum class AccessPattern {
+    normal,
+    sequential,  // read ahead aggressively, drop pages behind the reader
+    random,      // no read-ahead
+    will_need,   // start reading the range in now
+    dont_need,   // the range can be evicted
+};
+
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+class MappedVectorView {
+private:
+    ics_detail::MappedFile m_file;
+    const T* m_data;
+    size_t m_size;
+
+    static int madvise_flag(AccessPattern pattern) noexcept {
+        switch (pattern) {
+        case AccessPattern::sequential:
+            return MADV_SEQUENTIAL;
+        case AccessPattern::random:
+            return MADV_RANDOM;
+        case AccessPattern::will_need:
+            return MADV_WILLNEED;
+        case AccessPattern::dont_need:
+            return MADV_DONTNEED;
+        default:
+            return MADV_NORMAL;
+        }
+    }
+
+public:
+    // The file may be longer than the elements it holds, as files kept by
+    // PersistentVector are.
+    explicit MappedVectorView(const std::string& path, AccessPattern pattern = AccessPattern::normal)
+        : m_file(path), m_data(nullptr), m_size(0) {
+        if (m_file.size() < sizeof(BinaryHeader)) {
+            throw VectorException("binary vector file " + path + " is truncated");
+        }
+        BinaryHeader header;
+        std::memcpy(&header, m_file.data(), sizeof(header));
+        size_t count = ics_detail::check_binary_header<T>(header);
+        if (header.flags & BinaryHeader::flag_compressed) {
+            throw VectorException("compressed binary vector " + path + " cannot be mapped");
+        }
+        if ((m_file.size() - sizeof(BinaryHeader)) / sizeof(T) < count) {
+            throw VectorException("binary vector file " + path + " is truncated");
+        }
+        if (sizeof(BinaryHeader) % alignof(T) != 0) {
+            throw VectorException("binary vector data in " + path + " is misaligned");
+        }
+        m_data = reinterpret_cast<const T*>(m_file.data() + sizeof(BinaryHeader));
+        m_size = count;
+        if (pattern != AccessPattern::normal) {
+            advise(pattern);
+        }
+    }
+
+    // Applies an access hint to elements [first, first + count).
+    void advise(AccessPattern pattern, size_t first = 0, size_t count = SIZE_MAX) const noexcept {
+        if (first >= m_size) {
+            return;
+        }
+        count = std::min(count, m_size - first);
+        m_file.advise(sizeof(BinaryHeader) + first * sizeof(T), count * sizeof(T), madvise_flag(pattern));
+    }
+
+    size_t size() const noexcept {
+        return m_size;
+    }
+
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    const T* data() const noexcept {
+        return m_data;
+    }
+
+    const T* begin() const noexcept {
+        return m_data;
+    }
+
+    const T* end() const noexcept {
+        return m_data + m_size;
+    }
+
+    const T& front() const noexcept {
+        return m_data[0];
+    }
+
+    const T& back() const noexcept {
+        return m_data[m_size - 1];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return m_data[index];
+    }
+
+    const T& at(size_t index) const {
+        if (index >= m_size) {
+            throw VectorException("out of bounds");
+        }
+        return m_data[index];
+    }
+
+    bool operator==(const MappedVectorView& other) const noexcept {
+        return m_size == other.m_size && std::equal(begin(), end(), other.begin());
+    }
+
+    bool operator==(const Vector<T>& other) const noexcept {
+        return m_size == other.size() && std::equal(begin(), end(), other.begin());
+    }
+
+    Vector<T> to_vector() const {
+        Vector<T> result;
+        std::memcpy(result.append_uninitialized(m_size), m_data, m_size * sizeof(T));
+        return result;
+    }
+};
+
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+MappedVectorView<T> map_binary(const std::string& path, AccessPattern pattern = AccessPattern::normal) {
+    return MappedVectorView<T>(path, pattern);
+}
+
+#endif
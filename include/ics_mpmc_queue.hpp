@@ -0,0 +1,242 @@
+#ifndef ICS_MPMC_QUEUE_HPP
+#define ICS_MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "ics_cache_line.hpp"
+#include "ics_vector.hpp"
+
+// Bounded lock-free multi-producer multi-consumer queue (Vyukov's design).
+// Every slot carries a sequence number telling whose turn it is: a slot at
+// position p is free for the producer claiming p when its sequence is p,
+// and holds a value for the consumer claiming p when it is p + 1. Producers
+// and consumers claim positions with a CAS on their own counter and then
+// touch only their slot, so the two sides never contend with each other.
+//
+// Slots are cache-line aligned in one Vector allocation, so neighbouring
+// positions handled by different threads do not share a line. push and pop
+// spin briefly and then park on the slot's sequence with atomic::wait;
+// every try_ operation notifies that sequence after updating it.
+
+template <typename T>
+    requires std::is_default_constructible_v<T>
+class MpmcQueue {
+private:
+    struct alignas(ics_detail::cache_line_size) Slot {
+        std::atomic<size_t> sequence;
+        T value;
+
+        explicit Slot(size_t position) : sequence(position), value() {}
+
+        // only while the queue is being built
+        Slot(const Slot& other) : sequence(other.sequence.load(std::memory_order_relaxed)), value(other.value) {}
+    };
+
+    static constexpr int spin_limit = 64;
+
+    Vector<Slot> m_slots;
+    size_t m_mask;
+    alignas(ics_detail::cache_line_size) std::atomic<size_t> m_enqueue;
+    alignas(ics_detail::cache_line_size) std::atomic<size_t> m_dequeue;
+
+    static Vector<Slot> make_slots(size_t capacity) {
+        Vector<Slot> slots(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            slots.push_back(Slot(i));
+        }
+        return slots;
+    }
+
+    Slot& slot(size_t position) noexcept {
+        return m_slots[position & m_mask];
+    }
+
+    // Claims up to wanted consecutive positions on counter whose slots have
+    // sequence position + ready_offset. Returns the first and sets wanted to
+    // the number claimed, 0 if none is ready.
+    size_t claim(std::atomic<size_t>& counter, size_t ready_offset, size_t& wanted) noexcept {
+        size_t position = counter.load(std::memory_order_relaxed);
+        while (true) {
+            size_t ready = 0;
+            bool behind = false;
+            for (; ready < wanted; ++ready) {
+                size_t sequence = slot(position + ready).sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::intptr_t>(sequence - (position + ready + ready_offset));
+                if (diff != 0) {
+                    // ahead of us: another thread already claimed position
+                    behind = diff > 0 && ready == 0;
+                    break;
+                }
+            }
+            if (behind) {
+                position = counter.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (ready == 0) {
+                wanted = 0;
+                return position;
+            }
+            if (counter.compare_exchange_weak(position, position + ready, std::memory_order_relaxed)) {
+                wanted = ready;
+                return position;
+            }
+        }
+    }
+
+    void publish(Slot& target, size_t sequence) noexcept {
+        target.sequence.store(sequence, std::memory_order_release);
+        target.sequence.notify_all();
+    }
+
+    // Parks until the slot at counter's current position changes, unless it
+    // already has the sequence the caller waits for.
+    void park(std::atomic<size_t>& counter, size_t ready_offset) noexcept {
+        size_t position = counter.load(std::memory_order_relaxed);
+        Slot& target = slot(position);
+        size_t sequence = target.sequence.load(std::memory_order_acquire);
+        if (sequence != position + ready_offset && counter.load(std::memory_order_relaxed) == position) {
+            target.sequence.wait(sequence, std::memory_order_acquire);
+        }
+    }
+
+public:
+    // capacity is rounded up to a power of two.
+    explicit MpmcQueue(size_t capacity)
+        : m_slots(make_slots(std::bit_ceil(capacity > 1 ? capacity : 2))),
+          m_mask(m_slots.size() - 1),
+          m_enqueue(0),
+          m_dequeue(0) {}
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    size_t capacity() const noexcept {
+        return m_mask + 1;
+    }
+
+    // Approximate while other threads are running.
+    size_t size() const noexcept {
+        size_t dequeued = m_dequeue.load(std::memory_order_acquire);
+        size_t enqueued = m_enqueue.load(std::memory_order_acquire);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    // False if the queue is full.
+    template <typename U>
+    bool try_push(U&& value) {
+        size_t count = 1;
+        size_t position = claim(m_enqueue, 0, count);
+        if (count == 0) {
+            return false;
+        }
+        Slot& target = slot(position);
+        target.value = std::forward<U>(value);
+        publish(target, position + 1);
+        return true;
+    }
+
+    // False if the queue is empty.
+    bool try_pop(T& out) {
+        size_t count = 1;
+        size_t position = claim(m_dequeue, 1, count);
+        if (count == 0) {
+            return false;
+        }
+        Slot& target = slot(position);
+        out = std::move(target.value);
+        publish(target, position + capacity());
+        return true;
+    }
+
+    // Moves as many leading values as there are consecutive free slots,
+    // claimed with one CAS, and returns how many.
+    size_t try_push_n(std::span<T> values) {
+        size_t count = values.size();
+        size_t position = claim(m_enqueue, 0, count);
+        for (size_t i = 0; i < count; ++i) {
+            Slot& target = slot(position + i);
+            target.value = std::move(values[i]);
+            publish(target, position + i + 1);
+        }
+        return count;
+    }
+
+    // Moves up to out.size() consecutive values into out and returns how many.
+    size_t try_pop_n(std::span<T> out) {
+        size_t count = out.size();
+        size_t position = claim(m_dequeue, 1, count);
+        for (size_t i = 0; i < count; ++i) {
+            Slot& target = slot(position + i);
+            out[i] = std::move(target.value);
+            publish(target, position + i + capacity());
+        }
+        return count;
+    }
+
+    // Blocks while the queue is full.
+    template <typename U>
+    void push(U&& value) {
+        // try_push only moves from value once it has claimed a slot
+        for (int spin = 0; !try_push(std::forward<U>(value)); ++spin) {
+            if (spin < spin_limit) {
+                ics_detail::spin_pause();
+            } else {
+                park(m_enqueue, 0);
+            }
+        }
+    }
+
+    // Blocks while the queue is empty.
+    T pop() {
+        T out;
+        for (int spin = 0; !try_pop(out); ++spin) {
+            if (spin < spin_limit) {
+                ics_detail::spin_pause();
+            } else {
+                park(m_dequeue, 1);
+            }
+        }
+        return out;
+    }
+
+    // Blocks until every value has been pushed.
+    void push_n(std::span<T> values) {
+        for (int spin = 0; !values.empty(); ++spin) {
+            size_t pushed = try_push_n(values);
+            values = values.subspan(pushed);
+            if (pushed > 0) {
+                spin = 0;
+            } else if (spin < spin_limit) {
+                ics_detail::spin_pause();
+            } else {
+                park(m_enqueue, 0);
+            }
+        }
+    }
+
+    // Blocks until at least one value arrives, then takes up to out.size().
+    // An empty out returns 0 at once.
+    size_t pop_n(std::span<T> out) {
+        if (out.empty()) {
+            return 0;
+        }
+        for (int spin = 0;; ++spin) {
+            size_t popped = try_pop_n(out);
+            if (popped > 0) {
+                return popped;
+            }
+            if (spin < spin_limit) {
+                ics_detail::spin_pause();
+            } else {
+                park(m_dequeue, 1);
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef ICS_NPY_HPP
+#define ICS_NPY_HPP
+
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "ics_file.hpp"
+#include "ics_vector.hpp"
+#include "vector_exception.hpp"
+
+// NumPy .npy files holding one-dimensional arrays of arithmetic T.
+template <typename T>
+concept NpyElement = std::is_arithmetic_v<T> && sizeof(T) <= 8;
+
+namespace ics_detail {
+    inline constexpr char npy_magic[] = "\x93NUMPY";
+    inline constexpr size_t npy_magic_size = 6;
+
+    template <NpyElement T>
+    std::string npy_descr() {
+        char order = sizeof(T) == 1 ? '|' : (std::endian::native == std::endian::little ? '<' : '>');
+        char kind = std::is_same_v<T, bool> ? 'b'
+            : std::is_floating_point_v<T> ? 'f'
+            : std::is_signed_v<T> ? 'i' : 'u';
+        return std::string{order, kind} + std::to_string(sizeof(T));
+    }
+
+    struct NpyHeader {
+        std::string descr;
+        bool fortran_order;
+        Vector<size_t> shape;
+        size_t data_offset;
+    };
+
+    // Size of the magic, version and header-length fields for a file version.
+    inline size_t npy_preamble_size(const unsigned char* bytes) {
+        if (std::memcmp(bytes, npy_magic, npy_magic_size) != 0) {
+            throw VectorException("not an npy file");
+        }
+        unsigned char major = bytes[npy_magic_size];
+        if (major < 1 || major > 3) {
+            throw VectorException("unsupported npy version " + std::to_string(major));
+        }
+        return major == 1 ? 10 : 12;
+    }
+
+    inline size_t npy_header_length(const unsigned char* bytes, size_t preamble) noexcept {
+        size_t length = size_t{bytes[8]} | size_t{bytes[9]} << 8;
+        if (preamble == 12) {
+            length |= size_t{bytes[10]} << 16 | size_t{bytes[11]} << 24;
+        }
+        return length;
+    }
+
+    // Text following key's ':' in the header dictionary, without leading spaces.
+    inline std::string_view npy_value(std::string_view dict, std::string_view key) {
+        for (char quote : {'\'', '"'}) {
+            std::string quoted = quote + std::string(key) + quote;
+            size_t at = dict.find(quoted);
+            if (at == std::string_view::npos) {
+                continue;
+            }
+            size_t colon = dict.find(':', at + quoted.size());
+            if (colon != std::string_view::npos) {
+                size_t start = dict.find_first_not_of(' ', colon + 1);
+                if (start != std::string_view::npos) {
+                    return dict.substr(start);
+                }
+            }
+        }
+        throw VectorException("npy header lacks '" + std::string(key) + "'");
+    }
+
+    inline NpyHeader parse_npy_dict(std::string_view dict, size_t data_offset) {
+        NpyHeader header{};
+        header.data_offset = data_offset;
+
+        std::string_view descr = npy_value(dict, "descr");
+        size_t close = descr.empty() ? std::string_view::npos : descr.find(descr[0], 1);
+        if (close == std::string_view::npos || (descr[0] != '\'' && descr[0] != '"')) {
+            throw VectorException("malformed npy descr");
+        }
+        header.descr = std::string(descr.substr(1, close - 1));
+
+        std::string_view fortran = npy_value(dict, "fortran_order");
+        header.fortran_order = fortran.starts_with("True");
+
+        std::string_view shape = npy_value(dict, "shape");
+        size_t end = shape.find(')');
+        if (shape.empty() || shape[0] != '(' || end == std::string_view::npos) {
+            throw VectorException("malformed npy shape");
+        }
+        const char* cursor = shape.data() + 1;
+        const char* last = shape.data() + end;
+        while (cursor < last) {
+            if (*cursor == ' ' || *cursor == ',') {
+                ++cursor;
+                continue;
+            }
+            size_t extent = 0;
+            auto [next, error] = std::from_chars(cursor, last, extent);
+            if (error != std::errc()) {
+                throw VectorException("malformed npy shape");
+            }
+            header.shape.push_back(extent);
+            cursor = next;
+        }
+        return header;
+    }
+
+    // Checks header against T and returns the element count.
+    template <NpyElement T>
+    size_t check_npy_header(const NpyHeader& header) {
+        std::string expected = npy_descr<T>();
+        if (header.descr.size() < 3) {
+            throw VectorException("malformed npy descr '" + header.descr + "'");
+        }
+        char order = header.descr[0];
+        bool native = order == '|' || order == '='
+            || order == (std::endian::native == std::endian::little ? '<' : '>');
+        if (sizeof(T) > 1 && !native) {
+            throw VectorException("npy byte order of '" + header.descr + "' is not native");
+        }
+        if (header.descr.substr(1) != expected.substr(1)) {
+            throw VectorException("npy dtype '" + header.descr + "' does not match '" + expected + "'");
+        }
+        if (header.shape.size() != 1) {
+            throw VectorException("npy array is not one-dimensional");
+        }
+        if (header.shape[0] > SIZE_MAX / sizeof(T)) {
+            throw VectorException("npy shape is too large");
+        }
+        return header.shape[0];
+    }
+
+    inline NpyHeader read_npy_header(int fd) {
+        unsigned char preamble[12];
+        read_exact(fd, preamble, 10);
+        size_t preamble_size = npy_preamble_size(preamble);
+        if (preamble_size > 10) {
+            read_exact(fd, preamble + 10, preamble_size - 10);
+        }
+        size_t length = npy_header_length(preamble, preamble_size);
+        std::string dict(length, '\0');
+        read_exact(fd, dict.data(), length);
+        return parse_npy_dict(dict, preamble_size + length);
+    }
+}
+
+// Writes vec as a version 1.0 .npy file in native byte order.
+template <NpyElement T>
+void save_npy(const Vector<T>& vec, const std::string& path) {
+    std::string dict = "{'descr': '" + ics_detail::npy_descr<T>()
+        + "', 'fortran_order': False, 'shape': (" + std::to_string(vec.size()) + ",), }";
+    // pad so the data starts on a 64-byte boundary, as numpy does
+    size_t unpadded = 10 + dict.size() + 1;
+    dict.append((64 - unpadded % 64) % 64, ' ');
+    dict.push_back('\n');
+
+    std::string header(ics_detail::npy_magic, ics_detail::npy_magic_size);
+    header.push_back('\x01');
+    header.push_back('\x00');
+    header.push_back(static_cast<char>(dict.size() & 0xFF));
+    header.push_back(static_cast<char>(dict.size() >> 8));
+    header += dict;
+
+    ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_WRONLY | O_CREAT | O_TRUNC);
+    ics_detail::write_all(fd.get(), header.data(), header.size());
+    ics_detail::write_all(fd.get(), vec.data(), vec.size() * sizeof(T));
+}
+
+// Reads a .npy file into a Vector with one read of the whole payload.
+template <NpyElement T>
+Vector<T> load_npy(const std::string& path) {
+    ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_RDONLY);
+    ics_detail::NpyHeader header = ics_detail::read_npy_header(fd.get());
+    size_t count = ics_detail::check_npy_header<T>(header);
+    if (ics_detail::file_size(fd.get()) - header.data_offset < count * sizeof(T)) {
+        throw VectorException("npy file " + path + " is truncated");
+    }
+
+    Vector<T> result;
+    T* first = result.append_uninitialized(count);
+    ics_detail::read_exact(fd.get(), first, count * sizeof(T));
+    return result;
+}
+
+// Read-only view of a memory-mapped .npy file; elements are never copied.
+template <NpyElement T>
+class NpyView {
+private:
+    ics_detail::MappedFile m_file;
+    const T* m_data;
+    size_t m_size;
+
+public:
+    explicit NpyView(const std::string& path) : m_file(path), m_data(nullptr), m_size(0) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(m_file.data());
+        if (m_file.size() < 12) {
+            throw VectorException("npy file " + path + " is truncated");
+        }
+        size_t preamble = ics_detail::npy_preamble_size(bytes);
+        size_t length = ics_detail::npy_header_length(bytes, preamble);
+        if (m_file.size() < preamble + length) {
+            throw VectorException("npy file " + path + " is truncated");
+        }
+        ics_detail::NpyHeader header = ics_detail::parse_npy_dict(
+            std::string_view(m_file.data() + preamble, length), preamble + length);
+        m_size = ics_detail::check_npy_header<T>(header);
+        if (m_file.size() - header.data_offset < m_size * sizeof(T)) {
+            throw VectorException("npy file " + path + " is truncated");
+        }
+        if (header.data_offset % alignof(T) != 0) {
+            throw VectorException("npy data in " + path + " is misaligned");
+        }
+        m_data = reinterpret_cast<const T*>(m_file.data() + header.data_offset);
+    }
+
+    size_t size() const noexcept {
+        return m_size;
+    }
+
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    const T* data() const noexcept {
+        return m_data;
+    }
+
+    const T* begin() const noexcept {
+        return m_data;
+    }
+
+    const T* end() const noexcept {
+        return m_data + m_size;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return m_data[index];
+    }
+
+    const T& at(size_t index) const {
+        if (index >= m_size) {
+            throw VectorException("out of bounds");
+        }
+        return m_data[index];
+    }
+
+    Vector<T> to_vector() const {
+        Vector<T> result(m_size);
+        for (size_t i = 0; i < m_size; ++i) {
+            result.push_back(m_data[i]);
+        }
+        return result;
+    }
+};
+
+template <NpyElement T>
+NpyView<T> map_npy(const std::string& path) {
+    return NpyView<T>(path);
+}
+
+#endif
@@ -0,0 +1,253 @@
+#ifndef ICS_NULLABLE_VECTOR_HPP
+#define ICS_NULLABLE_VECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "ics_vector.hpp"
+#include "vector_exception.hpp"
+
+// Vector of optional values laid out like an Arrow primitive array: a dense
+// buffer of T (null slots hold T{}) plus a validity bitmap with one bit per
+// element, least significant bit first, set for valid elements. Reductions
+// skip nulls a 64-element bitmap word at a time.
+template <typename T>
+class NullableVector {
+private:
+    Vector<T> m_values;
+    Vector<uint64_t> m_validity;
+    size_t m_null_count;
+
+    void append_bit(bool valid) {
+        size_t index = m_values.size() - 1;
+        if (index % 64 == 0) {
+            m_validity.push_back(0);
+        }
+        if (valid) {
+            m_validity[index / 64] |= uint64_t{1} << (index % 64);
+        } else {
+            ++m_null_count;
+        }
+    }
+
+    // Calls f(index) for each valid element, and f_word(base, count) instead
+    // for each bitmap word whose count elements are all valid.
+    template <typename F, typename FWord>
+    void scan_valid(F&& f, FWord&& f_word) const {
+        size_t n = m_values.size();
+        for (size_t w = 0; w < m_validity.size(); ++w) {
+            uint64_t word = m_validity[w];
+            size_t base = w * 64;
+            size_t count = n - base < 64 ? n - base : 64;
+            uint64_t full = count == 64 ? ~uint64_t{0} : (uint64_t{1} << count) - 1;
+            if (word == full) {
+                f_word(base, count);
+                continue;
+            }
+            while (word != 0) {
+                f(base + static_cast<size_t>(__builtin_ctzll(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+    template <typename Better>
+    std::optional<T> extreme(Better&& better) const {
+        std::optional<T> best;
+        const T* values = m_values.data();
+        auto visit = [&](size_t i) {
+            if (!best || better(values[i], *best)) {
+                best = values[i];
+            }
+        };
+        scan_valid(visit, [&](size_t base, size_t count) {
+            for (size_t i = base; i < base + count; ++i) {
+                visit(i);
+            }
+        });
+        return best;
+    }
+
+public:
+    NullableVector() noexcept : m_null_count(0) {}
+
+    explicit NullableVector(const Vector<std::optional<T>>& values) : NullableVector() {
+        for (const std::optional<T>& value : values) {
+            push_back(value);
+        }
+    }
+
+    void push_back(const T& value) {
+        m_values.push_back(value);
+        append_bit(true);
+    }
+
+    void push_back(std::nullopt_t) {
+        m_values.push_back(T{});
+        append_bit(false);
+    }
+
+    void push_back(const std::optional<T>& value) {
+        if (value) {
+            push_back(*value);
+        } else {
+            push_back(std::nullopt);
+        }
+    }
+
+    void pop_back() {
+        if (m_values.empty()) {
+            throw VectorException("popping from empty");
+        }
+        size_t index = m_values.size() - 1;
+        if (!is_valid(index)) {
+            --m_null_count;
+        }
+        m_validity[index / 64] &= ~(uint64_t{1} << (index % 64));
+        if (index % 64 == 0) {
+            m_validity.pop_back();
+        }
+        m_values.pop_back();
+    }
+
+    bool is_valid(size_t index) const noexcept {
+        return (m_validity[index / 64] >> (index % 64)) & 1;
+    }
+
+    bool is_null(size_t index) const noexcept {
+        return !is_valid(index);
+    }
+
+    // Raw slot value; T{} for null elements.
+    const T& operator[](size_t index) const noexcept {
+        return m_values[index];
+    }
+
+    std::optional<T> get(size_t index) const {
+        if (!is_valid(index)) {
+            return std::nullopt;
+        }
+        return m_values[index];
+    }
+
+    std::optional<T> at(size_t index) const {
+        if (index >= m_values.size()) {
+            throw VectorException("out of bounds");
+        }
+        return get(index);
+    }
+
+    void set(size_t index, const T& value) {
+        if (index >= m_values.size()) {
+            throw VectorException("out of bounds");
+        }
+        if (!is_valid(index)) {
+            --m_null_count;
+            m_validity[index / 64] |= uint64_t{1} << (index % 64);
+        }
+        m_values[index] = value;
+    }
+
+    void set_null(size_t index) {
+        if (index >= m_values.size()) {
+            throw VectorException("out of bounds");
+        }
+        if (is_valid(index)) {
+            ++m_null_count;
+            m_validity[index / 64] &= ~(uint64_t{1} << (index % 64));
+        }
+        m_values[index] = T{};
+    }
+
+    size_t size() const noexcept {
+        return m_values.size();
+    }
+
+    bool empty() const noexcept {
+        return m_values.empty();
+    }
+
+    size_t null_count() const noexcept {
+        return m_null_count;
+    }
+
+    // Number of valid (non-null) elements.
+    size_t count() const noexcept {
+        return m_values.size() - m_null_count;
+    }
+
+    const T* data() const noexcept {
+        return m_values.data();
+    }
+
+    // Arrow validity bitmap: bit i of the little-endian words is element i.
+    const uint64_t* validity() const noexcept {
+        return m_validity.data();
+    }
+
+    // Calls f(index, value) for each valid element in order.
+    template <typename F>
+    void for_each_valid(F&& f) const {
+        const T* values = m_values.data();
+        scan_valid([&](size_t i) { f(i, values[i]); }, [&](size_t base, size_t count) {
+            for (size_t i = base; i < base + count; ++i) {
+                f(i, values[i]);
+            }
+        });
+    }
+
+    T sum() const requires std::is_arithmetic_v<T> {
+        const T* values = m_values.data();
+        T total{};
+        scan_valid([&](size_t i) { total += values[i]; }, [&](size_t base, size_t count) {
+            T partial{};
+            for (size_t i = base; i < base + count; ++i) {
+                partial += values[i];
+            }
+            total += partial;
+        });
+        return total;
+    }
+
+    std::optional<T> min() const {
+        return extreme([](const T& a, const T& b) { return a < b; });
+    }
+
+    std::optional<T> max() const {
+        return extreme([](const T& a, const T& b) { return b < a; });
+    }
+
+    Vector<std::optional<T>> to_vector() const {
+        Vector<std::optional<T>> result(size());
+        for (size_t i = 0; i < size(); ++i) {
+            result.push_back(get(i));
+        }
+        return result;
+    }
+
+    void clear() noexcept {
+        m_values.clear();
+        m_validity.clear();
+        m_null_count = 0;
+    }
+
+    bool operator==(const NullableVector& other) const {
+        if (size() != other.size() || m_null_count != other.m_null_count) {
+            return false;
+        }
+        for (size_t i = 0; i < size(); ++i) {
+            if (get(i) != other.get(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const NullableVector& other) const {
+        return !(*this == other);
+    }
+};
+
+#endif
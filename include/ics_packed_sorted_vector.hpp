@@ -0,0 +1,381 @@
+#ifndef ICS_PACKED_SORTED_VECTOR_HPP
+#define ICS_PACKED_SORTED_VECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "ics_vector.hpp"
+#include "vector_exception.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ics_detail {
+    // Blocks of 128 sorted values are delta coded with stride 4
+    // (d[i] = v[i] - v[i - 4], d[0..3] relative to the block's first value) and
+    // bit-packed into four interleaved 32-bit lanes: lane l holds d[l], d[l + 4],
+    // ... so word row r of a block is the four words packed[4r .. 4r + 3]. Both
+    // unpacking and the prefix sum then operate on whole rows of four values.
+    inline constexpr size_t packed_block_size = 128;
+
+    inline uint32_t bit_width(uint32_t x) noexcept {
+        return x == 0 ? 0 : 32 - static_cast<uint32_t>(__builtin_clz(x));
+    }
+
+    inline uint32_t low_mask(uint32_t bits) noexcept {
+        return bits >= 32 ? UINT32_MAX : (uint32_t{1} << bits) - 1;
+    }
+
+    // Packs the 128 values of in; out must hold 4 * bits zeroed words.
+    inline void pack_block(const uint32_t* in, uint32_t bits, uint32_t* out) noexcept {
+        if (bits == 0) {
+            return;
+        }
+        for (size_t lane = 0; lane < 4; ++lane) {
+            uint32_t bit_pos = 0;
+            for (size_t j = 0; j < packed_block_size / 4; ++j) {
+                uint32_t delta = in[4 * j + lane] - (j == 0 ? in[0] : in[4 * (j - 1) + lane]);
+                uint32_t row = bit_pos / 32;
+                uint32_t shift = bit_pos % 32;
+                out[4 * row + lane] |= delta << shift;
+                if (shift + bits > 32) {
+                    out[4 * (row + 1) + lane] |= delta >> (32 - shift);
+                }
+                bit_pos += bits;
+            }
+        }
+    }
+
+    inline void unpack_block_scalar(const uint32_t* in, uint32_t bits, uint32_t first,
+                                    uint32_t* out) noexcept {
+        uint32_t mask = low_mask(bits);
+        for (size_t lane = 0; lane < 4; ++lane) {
+            uint32_t value = first;
+            uint32_t bit_pos = 0;
+            for (size_t j = 0; j < packed_block_size / 4; ++j) {
+                uint32_t delta = 0;
+                if (bits > 0) {
+                    uint32_t row = bit_pos / 32;
+                    uint32_t shift = bit_pos % 32;
+                    delta = in[4 * row + lane] >> shift;
+                    if (shift + bits > 32) {
+                        delta |= in[4 * (row + 1) + lane] << (32 - shift);
+                    }
+                    delta &= mask;
+                }
+                value += delta;
+                out[4 * j + lane] = value;
+                bit_pos += bits;
+            }
+        }
+    }
+
+#if defined(__SSE2__)
+    inline void unpack_block_sse2(const uint32_t* in, uint32_t bits, uint32_t first,
+                                  uint32_t* out) noexcept {
+        __m128i value = _mm_set1_epi32(static_cast<int>(first));
+        __m128i* dst = reinterpret_cast<__m128i*>(out);
+        if (bits == 0) {
+            for (size_t j = 0; j < packed_block_size / 4; ++j) {
+                _mm_storeu_si128(dst + j, value);
+            }
+            return;
+        }
+
+        const __m128i* src = reinterpret_cast<const __m128i*>(in);
+        __m128i mask = _mm_set1_epi32(static_cast<int>(low_mask(bits)));
+        __m128i row = _mm_loadu_si128(src);
+        uint32_t shift = 0;
+        for (size_t j = 0; j < packed_block_size / 4; ++j) {
+            __m128i delta = _mm_srl_epi32(row, _mm_cvtsi32_si128(static_cast<int>(shift)));
+            shift += bits;
+            if (shift >= 32) {
+                shift -= 32;
+                if (j + 1 < packed_block_size / 4 || shift > 0) {
+                    row = _mm_loadu_si128(++src);
+                }
+                if (shift > 0) {
+                    delta = _mm_or_si128(delta,
+                        _mm_sll_epi32(row, _mm_cvtsi32_si128(static_cast<int>(bits - shift))));
+                }
+            }
+            value = _mm_add_epi32(value, _mm_and_si128(delta, mask));
+            _mm_storeu_si128(dst + j, value);
+        }
+    }
+#endif
+
+    inline void unpack_block(const uint32_t* in, uint32_t bits, uint32_t first,
+                             uint32_t* out) noexcept {
+#if defined(__SSE2__)
+        unpack_block_sse2(in, bits, first, out);
+#else
+        unpack_block_scalar(in, bits, first, out);
+#endif
+    }
+}
+
+// Append-only sorted sequence of uint32_t stored as bit-packed deltas in
+// blocks of 128. The first value of every full block doubles as a skip
+// pointer, so lower_bound decodes a single block. Values not yet filling a
+// block stay uncompressed in a tail buffer.
+class PackedSortedVector {
+private:
+    static constexpr size_t block_size = ics_detail::packed_block_size;
+
+    Vector<uint32_t> m_block_first;
+    Vector<size_t> m_block_offset;
+    Vector<uint8_t> m_block_bits;
+    Vector<uint32_t> m_packed;
+    Vector<uint32_t> m_tail;
+    size_t m_size;
+
+    void seal_tail() {
+        const uint32_t* values = m_tail.data();
+        uint32_t widest = 0;
+        for (size_t i = 4; i < block_size; ++i) {
+            widest |= values[i] - values[i - 4];
+        }
+        for (size_t i = 0; i < 4; ++i) {
+            widest |= values[i] - values[0];
+        }
+        uint32_t bits = ics_detail::bit_width(widest);
+
+        size_t offset = m_packed.size();
+        for (size_t i = 0; i < 4 * bits; ++i) {
+            m_packed.push_back(0);
+        }
+        ics_detail::pack_block(values, bits, m_packed.data() + offset);
+
+        m_block_first.push_back(values[0]);
+        m_block_offset.push_back(offset);
+        m_block_bits.push_back(static_cast<uint8_t>(bits));
+        m_tail.clear();
+    }
+
+    size_t block_count() const noexcept {
+        return m_block_first.size() + (m_tail.empty() ? 0 : 1);
+    }
+
+    uint32_t block_first(size_t block) const noexcept {
+        return block < m_block_first.size() ? m_block_first[block] : m_tail[0];
+    }
+
+    // Last block at or after from whose first value is < value, or
+    // block_count() if there is none. Runs of equal values may straddle block
+    // boundaries, so the comparison is strict.
+    size_t find_block(uint32_t value, size_t from) const noexcept {
+        size_t lo = from;
+        size_t hi = block_count();
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (block_first(mid) < value) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo == from ? block_count() : lo - 1;
+    }
+
+public:
+    // Forward cursor that decodes one block at a time and can skip ahead
+    // using the block skip pointers.
+    class Cursor {
+    private:
+        const PackedSortedVector* m_container;
+        size_t m_block;
+        size_t m_length;
+        size_t m_pos;
+        uint32_t m_buffer[block_size];
+
+        void load(size_t block) noexcept {
+            m_block = block;
+            m_pos = 0;
+            m_length = block < m_container->block_count()
+                ? m_container->decode_block(block, m_buffer) : 0;
+        }
+
+    public:
+        explicit Cursor(const PackedSortedVector& container) noexcept : m_container(&container) {
+            load(0);
+        }
+
+        bool valid() const noexcept {
+            return m_pos < m_length;
+        }
+
+        uint32_t value() const noexcept {
+            return m_buffer[m_pos];
+        }
+
+        size_t index() const noexcept {
+            return m_block * block_size + m_pos;
+        }
+
+        void next() noexcept {
+            if (++m_pos == m_length) {
+                load(m_block + 1);
+            }
+        }
+
+        // Advances to the first value >= target.
+        void seek(uint32_t target) noexcept {
+            if (!valid() || m_buffer[m_length - 1] < target) {
+                size_t block = m_container->find_block(target, m_block + 1);
+                if (block == m_container->block_count()) {
+                    block = m_block + 1;
+                }
+                load(block);
+            }
+            while (valid() && m_buffer[m_pos] < target) {
+                next();
+            }
+        }
+    };
+
+    PackedSortedVector() noexcept : m_size(0) {}
+
+    explicit PackedSortedVector(const Vector<uint32_t>& sorted) : PackedSortedVector() {
+        for (uint32_t value : sorted) {
+            push_back(value);
+        }
+    }
+
+    // Appends value, which must not be smaller than the current last value.
+    void push_back(uint32_t value) {
+        if (m_size > 0 && value < back()) {
+            throw VectorException("unsorted append");
+        }
+        if (m_tail.capacity() == 0) {
+            m_tail.resize(block_size);
+        }
+        m_tail.push_back(value);
+        ++m_size;
+        if (m_tail.size() == block_size) {
+            seal_tail();
+        }
+    }
+
+    // Decodes block into out (room for 128 values) and returns its length.
+    size_t decode_block(size_t block, uint32_t* out) const noexcept {
+        if (block == m_block_first.size()) {
+            std::memcpy(out, m_tail.data(), m_tail.size() * sizeof(uint32_t));
+            return m_tail.size();
+        }
+        ics_detail::unpack_block(m_packed.data() + m_block_offset[block], m_block_bits[block],
+                                 m_block_first[block], out);
+        return block_size;
+    }
+
+    uint32_t operator[](size_t index) const noexcept {
+        uint32_t buffer[block_size];
+        decode_block(index / block_size, buffer);
+        return buffer[index % block_size];
+    }
+
+    uint32_t at(size_t index) const {
+        if (index >= m_size) {
+            throw VectorException("out of bounds");
+        }
+        return (*this)[index];
+    }
+
+    uint32_t back() const noexcept {
+        if (!m_tail.empty()) {
+            return m_tail.back();
+        }
+        return (*this)[m_size - 1];
+    }
+
+    // Index of the first value >= value, or size() if there is none.
+    size_t lower_bound(uint32_t value) const noexcept {
+        if (m_size == 0 || value <= block_first(0)) {
+            return 0;
+        }
+        size_t block = find_block(value, 0);
+        uint32_t buffer[block_size];
+        size_t length = decode_block(block, buffer);
+        size_t lo = 0;
+        size_t hi = length;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (buffer[mid] < value) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return block * block_size + lo;
+    }
+
+    bool contains(uint32_t value) const noexcept {
+        size_t index = lower_bound(value);
+        return index < m_size && (*this)[index] == value;
+    }
+
+    size_t size() const noexcept {
+        return m_size;
+    }
+
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    template <typename F>
+    void for_each(F&& f) const {
+        uint32_t buffer[block_size];
+        for (size_t block = 0; block < block_count(); ++block) {
+            size_t length = decode_block(block, buffer);
+            for (size_t i = 0; i < length; ++i) {
+                f(buffer[i]);
+            }
+        }
+    }
+
+    Vector<uint32_t> to_vector() const {
+        Vector<uint32_t> result(m_size);
+        for_each([&result](uint32_t value) { result.push_back(value); });
+        return result;
+    }
+
+    size_t memory_bytes() const noexcept {
+        return m_block_first.capacity() * sizeof(uint32_t)
+            + m_block_offset.capacity() * sizeof(size_t)
+            + m_block_bits.capacity() * sizeof(uint8_t)
+            + m_packed.capacity() * sizeof(uint32_t)
+            + m_tail.capacity() * sizeof(uint32_t);
+    }
+
+    bool operator==(const PackedSortedVector& other) const noexcept {
+        return m_size == other.m_size && m_tail == other.m_tail && m_packed == other.m_packed
+            && m_block_first == other.m_block_first && m_block_bits == other.m_block_bits;
+    }
+
+    bool operator!=(const PackedSortedVector& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+// Sorted intersection that leapfrogs between the two inputs, skipping whole
+// blocks whenever one side falls behind.
+inline Vector<uint32_t> intersect(const PackedSortedVector& lhs, const PackedSortedVector& rhs) {
+    Vector<uint32_t> result;
+    PackedSortedVector::Cursor a(lhs);
+    PackedSortedVector::Cursor b(rhs);
+    while (a.valid() && b.valid()) {
+        if (a.value() < b.value()) {
+            a.seek(b.value());
+        } else if (b.value() < a.value()) {
+            b.seek(a.value());
+        } else {
+            result.push_back(a.value());
+            a.next();
+            b.next();
+        }
+    }
+    return result;
+}
+
+#endif
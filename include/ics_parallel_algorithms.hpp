@@ -0,0 +1,238 @@
+#ifndef ICS_PARALLEL_ALGORITHMS_HPP
+#define ICS_PARALLEL_ALGORITHMS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "ics_cache_line.hpp"
+#include "ics_thread_pool.hpp"
+#include "ics_vector.hpp"
+
+// Data-parallel loops over Vectors and plain (pointer, count) ranges, run
+// on a work-stealing ThreadPool.
+//
+// A range is cut into chunks of at least grain elements. With grain = 0
+// chunks hold at least 16 KiB (half a typical L1d) and there are about
+// four per worker, enough for stealing to even out uneven work without
+// drowning it in task overhead. Chunks hold a multiple of a cache line's
+// worth of elements; Vector storage is not line-aligned, so neighbouring
+// chunks may still share the one line at their boundary. The chunks are
+// handed out by recursive halving with parallel_invoke, which lets idle
+// workers steal large halves first. Small ranges and one-worker pools run
+// inline on the calling thread.
+//
+// Functors are called concurrently from several threads. parallel_reduce
+// combines chunk results in order, so with a fixed grain and pool size a
+// non-commutative (or floating-point) op gives the same answer every run.
+
+struct ParallelOptions {
+    size_t grain = 0;              // minimum elements per chunk; 0 picks one
+    ThreadPool* pool = nullptr;    // nullptr uses ThreadPool::global()
+};
+
+namespace ics_detail {
+    inline constexpr size_t min_chunk_bytes = 16 * 1024;
+    inline constexpr size_t chunks_per_worker = 4;
+
+    // How [0, n) is cut into chunks for a pool.
+    class ChunkPlan {
+    private:
+        ThreadPool* m_pool;
+        size_t m_n;
+        size_t m_chunk;
+        size_t m_count;
+
+        template <typename F>
+        void split(size_t first_chunk, size_t last_chunk, F& f) const {
+            if (last_chunk - first_chunk == 1) {
+                f(first_chunk, first_chunk * m_chunk, std::min(m_n, last_chunk * m_chunk));
+                return;
+            }
+            size_t middle = first_chunk + (last_chunk - first_chunk) / 2;
+            parallel_invoke(
+                *m_pool, [&] { split(first_chunk, middle, f); }, [&] { split(middle, last_chunk, f); });
+        }
+
+    public:
+        ChunkPlan(size_t n, size_t element_size, const ParallelOptions& options)
+            : m_pool(options.pool != nullptr ? options.pool : &ThreadPool::global()), m_n(n) {
+            size_t line = std::max<size_t>(1, cache_line_size / std::max<size_t>(1, element_size));
+            size_t grain = options.grain != 0 ? options.grain : std::max<size_t>(1, min_chunk_bytes / element_size);
+            size_t target = m_pool->size() * chunks_per_worker;
+            m_chunk = std::max(grain, (n + target - 1) / target);
+            m_chunk = (m_chunk + line - 1) / line * line;
+            m_count = m_pool->size() == 1 ? 1 : (n + m_chunk - 1) / m_chunk;
+            if (m_count == 1) {
+                m_chunk = n;
+            }
+        }
+
+        size_t count() const noexcept {
+            return m_count;
+        }
+
+        // Calls f(chunk, first, last) for every chunk, inline when there is
+        // only one.
+        template <typename F>
+        void run(F&& f) const {
+            if (m_n == 0) {
+                return;
+            }
+            if (m_count == 1) {
+                f(size_t{0}, size_t{0}, m_n);
+                return;
+            }
+            split(0, m_count, f);
+        }
+    };
+
+    // A Vector<U> of n elements to be overwritten in parallel: uninitialized
+    // for trivially copyable U, default-constructed otherwise.
+    template <typename U>
+    Vector<U> presized(size_t n) {
+        Vector<U> result(n);
+        if constexpr (std::is_trivially_copyable_v<U>) {
+            result.append_uninitialized(n);
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                result.push_back(U());
+            }
+        }
+        return result;
+    }
+}
+
+template <typename T, typename F>
+void parallel_for_each(T* first, size_t count, F f, const ParallelOptions& options = {}) {
+    ics_detail::ChunkPlan(count, sizeof(T), options).run([&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            f(first[i]);
+        }
+    });
+}
+
+// Calls f(T&) on every element.
+template <typename T, typename F>
+void parallel_for_each(Vector<T>& vec, F f, const ParallelOptions& options = {}) {
+    if (!vec.empty()) {
+        parallel_for_each(&vec[0], vec.size(), f, options);
+    }
+}
+
+// out[i] = f(first[i]) for every i; out must hold count elements.
+template <typename T, typename U, typename F>
+void parallel_transform(const T* first, size_t count, U* out, F f, const ParallelOptions& options = {}) {
+    ics_detail::ChunkPlan(count, std::max(sizeof(T), sizeof(U)), options).run([&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            out[i] = f(first[i]);
+        }
+    });
+}
+
+// A Vector of f applied to each element. A non-trivially-copyable result
+// type is default-constructed serially first, then assigned in parallel.
+template <typename T, typename F, typename U = std::decay_t<std::invoke_result_t<F&, const T&>>>
+Vector<U> parallel_transform(const Vector<T>& vec, F f, const ParallelOptions& options = {}) {
+    Vector<U> result = ics_detail::presized<U>(vec.size());
+    if (!vec.empty()) {
+        parallel_transform(vec.data(), vec.size(), &result[0], f, options);
+    }
+    return result;
+}
+
+// Folds op over init and the elements; op must be associative.
+template <typename T, typename Op>
+T parallel_reduce(const T* first, size_t count, std::type_identity_t<T> init, Op op, const ParallelOptions& options = {}) {
+    ics_detail::ChunkPlan plan(count, sizeof(T), options);
+    Vector<std::optional<T>> partials(plan.count());
+    for (size_t c = 0; c < plan.count(); ++c) {
+        partials.push_back(std::nullopt);
+    }
+    plan.run([&](size_t chunk, size_t begin, size_t end) {
+        T partial = first[begin];
+        for (size_t i = begin + 1; i < end; ++i) {
+            partial = op(std::move(partial), first[i]);
+        }
+        partials[chunk] = std::move(partial);
+    });
+    for (std::optional<T>& partial : partials) {
+        if (partial) {
+            init = op(std::move(init), std::move(*partial));
+        }
+    }
+    return init;
+}
+
+template <typename T, typename Op>
+T parallel_reduce(const Vector<T>& vec, std::type_identity_t<T> init, Op op, const ParallelOptions& options = {}) {
+    return parallel_reduce(vec.data(), vec.size(), std::move(init), op, options);
+}
+
+template <typename T, typename Pred>
+size_t parallel_count_if(const T* first, size_t count, Pred pred, const ParallelOptions& options = {}) {
+    ics_detail::ChunkPlan plan(count, sizeof(T), options);
+    Vector<size_t> counts(plan.count());
+    for (size_t c = 0; c < plan.count(); ++c) {
+        counts.push_back(0);
+    }
+    plan.run([&](size_t chunk, size_t begin, size_t end) {
+        size_t matches = 0;
+        for (size_t i = begin; i < end; ++i) {
+            matches += pred(first[i]) ? 1 : 0;
+        }
+        counts[chunk] = matches;
+    });
+    size_t total = 0;
+    for (size_t matches : counts) {
+        total += matches;
+    }
+    return total;
+}
+
+template <typename T, typename Pred>
+size_t parallel_count_if(const Vector<T>& vec, Pred pred, const ParallelOptions& options = {}) {
+    return parallel_count_if(vec.data(), vec.size(), pred, options);
+}
+
+template <typename T>
+void parallel_fill(T* first, size_t count, const std::type_identity_t<T>& value, const ParallelOptions& options = {}) {
+    ics_detail::ChunkPlan(count, sizeof(T), options).run([&](size_t, size_t begin, size_t end) {
+        std::fill(first + begin, first + end, value);
+    });
+}
+
+// Assigns value to every element.
+template <typename T>
+void parallel_fill(Vector<T>& vec, const std::type_identity_t<T>& value, const ParallelOptions& options = {}) {
+    if (!vec.empty()) {
+        parallel_fill(&vec[0], vec.size(), value, options);
+    }
+}
+
+// out[i] = first[i] for every i; out must hold count elements and not
+// overlap the source.
+template <typename T>
+void parallel_copy(const T* first, size_t count, T* out, const ParallelOptions& options = {}) {
+    ics_detail::ChunkPlan(count, sizeof(T), options).run([&](size_t, size_t begin, size_t end) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memcpy(out + begin, first + begin, (end - begin) * sizeof(T));
+        } else {
+            std::copy(first + begin, first + end, out + begin);
+        }
+    });
+}
+
+// A copy of vec, see parallel_transform for non-trivially-copyable T.
+template <typename T>
+Vector<T> parallel_copy(const Vector<T>& vec, const ParallelOptions& options = {}) {
+    Vector<T> result = ics_detail::presized<T>(vec.size());
+    if (!vec.empty()) {
+        parallel_copy(vec.data(), vec.size(), &result[0], options);
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef ICS_PARALLEL_SCAN_HPP
+#define ICS_PARALLEL_SCAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "ics_parallel_algorithms.hpp"
+#include "ics_vector.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Prefix sums and stream compaction in two passes over the chunks of
+// ics_parallel_algorithms.hpp. The first pass reduces (or counts) every
+// chunk, a short serial scan over the chunk results gives each chunk its
+// starting value (or output offset), and the second pass scans (or copies)
+// every chunk from there. Output goes into a Vector sized up front, never
+// through push_back.
+//
+// Integer sums with std::plus scan four 32-bit or two 64-bit lanes at a
+// time in SSE2 registers; other types and operations use a scalar loop.
+// Predicates run twice per element and must give the same answer both times.
+
+namespace ics_detail {
+    template <typename T, typename Op>
+    constexpr bool simd_plus_scan() noexcept {
+#if defined(__SSE2__)
+        return (std::is_same_v<Op, std::plus<>> || std::is_same_v<Op, std::plus<T>>) && std::is_integral_v<T> &&
+               (sizeof(T) == 4 || sizeof(T) == 8);
+#else
+        return false;
+#endif
+    }
+
+#if defined(__SSE2__)
+    // Inclusive sum of in[0, n) plus carry into out; returns the last sum.
+    // Within a register the prefix is built by adding copies shifted by one
+    // and two lanes, then the running carry is added to every lane.
+    template <typename T>
+    T scan_plus_sse2(const T* in, size_t n, T* out, T carry) noexcept {
+        constexpr size_t lanes = 16 / sizeof(T);
+        using U = std::make_unsigned_t<T>;
+        size_t i = 0;
+        if constexpr (sizeof(T) == 4) {
+            __m128i running = _mm_set1_epi32(static_cast<int>(carry));
+            for (; i + lanes <= n; i += lanes) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+                x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+                x = _mm_add_epi32(x, running);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), x);
+                running = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+            }
+            carry = static_cast<T>(static_cast<U>(_mm_cvtsi128_si32(running)));
+        } else {
+            __m128i running = _mm_set1_epi64x(static_cast<long long>(carry));
+            for (; i + lanes <= n; i += lanes) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+                x = _mm_add_epi64(x, running);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), x);
+                running = _mm_unpackhi_epi64(x, x);
+            }
+            carry = static_cast<T>(static_cast<U>(_mm_cvtsi128_si64(running)));
+        }
+        for (; i < n; ++i) {
+            // unsigned arithmetic wraps like the vector lanes do
+            carry = static_cast<T>(static_cast<U>(carry) + static_cast<U>(in[i]));
+            out[i] = carry;
+        }
+        return carry;
+    }
+#endif
+
+    // Inclusive scan of in[0, n) into out, continuing from carry if given.
+    template <typename T, typename Op>
+    void scan_chunk(const T* in, size_t n, T* out, std::optional<T> carry, Op& op) {
+#if defined(__SSE2__)
+        if constexpr (simd_plus_scan<T, Op>()) {
+            scan_plus_sse2(in, n, out, carry ? *carry : T(0));
+            return;
+        }
+#endif
+        size_t i = 0;
+        if (!carry) {
+            carry = in[0];
+            out[0] = *carry;
+            i = 1;
+        }
+        T acc = std::move(*carry);
+        for (; i < n; ++i) {
+            acc = op(std::move(acc), in[i]);
+            out[i] = acc;
+        }
+    }
+
+    // Chunk reductions of the first pass, turned into the value each chunk
+    // continues from: none for the first chunk of an inclusive scan.
+    template <typename T, typename Op>
+    Vector<std::optional<T>> scan_offsets(const T* first, const ChunkPlan& plan, std::optional<T> init, Op& op) {
+        Vector<std::optional<T>> sums(plan.count());
+        for (size_t c = 0; c < plan.count(); ++c) {
+            sums.push_back(std::nullopt);
+        }
+        plan.run([&](size_t chunk, size_t begin, size_t end) {
+            T sum = first[begin];
+            for (size_t i = begin + 1; i < end; ++i) {
+                sum = op(std::move(sum), first[i]);
+            }
+            sums[chunk] = std::move(sum);
+        });
+        Vector<std::optional<T>> offsets(plan.count());
+        std::optional<T> running = std::move(init);
+        for (std::optional<T>& sum : sums) {
+            offsets.push_back(running);
+            if (sum) {
+                running = running ? op(std::move(*running), std::move(*sum)) : std::move(*sum);
+            }
+        }
+        return offsets;
+    }
+
+    // Elements of every chunk satisfying pred.
+    template <typename T, typename Pred>
+    Vector<size_t> chunk_matches(const T* first, const ChunkPlan& plan, Pred& pred) {
+        Vector<size_t> counts(plan.count());
+        for (size_t c = 0; c < plan.count(); ++c) {
+            counts.push_back(0);
+        }
+        plan.run([&](size_t chunk, size_t begin, size_t end) {
+            size_t matches = 0;
+            for (size_t i = begin; i < end; ++i) {
+                matches += pred(first[i]) ? 1 : 0;
+            }
+            counts[chunk] = matches;
+        });
+        return counts;
+    }
+}
+
+// out[i] = first[0] op ... op first[i]. op must be associative; out may be
+// first.
+template <typename T, typename Op = std::plus<>>
+void parallel_inclusive_scan(const T* first, size_t count, T* out, Op op = {}, const ParallelOptions& options = {}) {
+    ics_detail::ChunkPlan plan(count, sizeof(T), options);
+    if (plan.count() == 1) {
+        if (count > 0) {
+            ics_detail::scan_chunk(first, count, out, std::optional<T>(), op);
+        }
+        return;
+    }
+    Vector<std::optional<T>> offsets = ics_detail::scan_offsets(first, plan, std::optional<T>(), op);
+    plan.run([&](size_t chunk, size_t begin, size_t end) {
+        ics_detail::scan_chunk(first + begin, end - begin, out + begin, offsets[chunk], op);
+    });
+}
+
+// out[i] = init op first[0] op ... op first[i - 1]; out may be first.
+template <typename T, typename Op = std::plus<>>
+void parallel_exclusive_scan(const T* first, size_t count, T* out, std::type_identity_t<T> init, Op op = {},
+                             const ParallelOptions& options = {}) {
+    ics_detail::ChunkPlan plan(count, sizeof(T), options);
+    auto scan = [&](size_t begin, size_t end, T acc) {
+        for (size_t i = begin; i < end; ++i) {
+            T next = op(acc, first[i]);
+            out[i] = std::move(acc);
+            acc = std::move(next);
+        }
+    };
+    if (plan.count() == 1) {
+        scan(0, count, std::move(init));
+        return;
+    }
+    Vector<std::optional<T>> offsets = ics_detail::scan_offsets(first, plan, std::optional<T>(std::move(init)), op);
+    plan.run([&](size_t chunk, size_t begin, size_t end) {
+        scan(begin, end, *offsets[chunk]);
+    });
+}
+
+template <typename T, typename Op = std::plus<>>
+Vector<T> parallel_inclusive_scan(const Vector<T>& vec, Op op = {}, const ParallelOptions& options = {}) {
+    Vector<T> result = ics_detail::presized<T>(vec.size());
+    if (!vec.empty()) {
+        parallel_inclusive_scan(vec.data(), vec.size(), &result[0], op, options);
+    }
+    return result;
+}
+
+template <typename T, typename Op = std::plus<>>
+Vector<T> parallel_exclusive_scan(const Vector<T>& vec, std::type_identity_t<T> init, Op op = {},
+                                  const ParallelOptions& options = {}) {
+    Vector<T> result = ics_detail::presized<T>(vec.size());
+    if (!vec.empty()) {
+        parallel_exclusive_scan(vec.data(), vec.size(), &result[0], std::move(init), op, options);
+    }
+    return result;
+}
+
+// The elements satisfying pred, in their original order.
+template <typename T, typename Pred>
+Vector<T> parallel_copy_if(const Vector<T>& vec, Pred pred, const ParallelOptions& options = {}) {
+    const T* first = vec.data();
+    ics_detail::ChunkPlan plan(vec.size(), sizeof(T), options);
+    Vector<size_t> offsets = ics_detail::chunk_matches(first, plan, pred);
+    size_t total = 0;
+    for (size_t& offset : offsets) {
+        total += std::exchange(offset, total);
+    }
+    Vector<T> result = ics_detail::presized<T>(total);
+    plan.run([&](size_t chunk, size_t begin, size_t end) {
+        size_t slot = offsets[chunk];
+        for (size_t i = begin; i < end; ++i) {
+            if (pred(first[i])) {
+                result[slot++] = first[i];
+            }
+        }
+    });
+    return result;
+}
+
+// Stable partition: the elements satisfying pred move to the front, both
+// groups keeping their order. Returns how many satisfy pred.
+template <typename T, typename Pred>
+size_t parallel_partition(Vector<T>& vec, Pred pred, const ParallelOptions& options = {}) {
+    if (vec.empty()) {
+        return 0;
+    }
+    T* first = &vec[0];
+    ics_detail::ChunkPlan plan(vec.size(), sizeof(T), options);
+    Vector<size_t> matches = ics_detail::chunk_matches(static_cast<const T*>(first), plan, pred);
+    size_t selected = 0;
+    for (size_t count : matches) {
+        selected += count;
+    }
+    // chunk c starting at begin moves its matches to true_offsets[c] and the
+    // rest to selected + (begin - true_offsets[c])
+    Vector<size_t> true_offsets(plan.count());
+    size_t running = 0;
+    for (size_t count : matches) {
+        true_offsets.push_back(running);
+        running += count;
+    }
+    Vector<T> result = ics_detail::presized<T>(vec.size());
+    plan.run([&](size_t chunk, size_t begin, size_t end) {
+        size_t true_slot = true_offsets[chunk];
+        size_t false_slot = selected + (begin - true_slot);
+        for (size_t i = begin; i < end; ++i) {
+            if (pred(static_cast<const T&>(first[i]))) {
+                result[true_slot++] = std::move(first[i]);
+            } else {
+                result[false_slot++] = std::move(first[i]);
+            }
+        }
+    });
+    vec = std::move(result);
+    return selected;
+}
+
+#endif
@@ -0,0 +1,295 @@
+#ifndef ICS_PERSISTENT_VECTOR_HPP
+#define ICS_PERSISTENT_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "ics_file.hpp"
+#include "ics_vector.hpp"
+#include "ics_vector_io.hpp"
+#include "vector_exception.hpp"
+
+// Vector whose storage is a shared, writable mapping of a file in the binary
+// Vector format. Elements live directly in the file after the BinaryHeader;
+// the file is extended with ftruncate and remapped when it runs out of room,
+// so it is usually longer than the elements it holds.
+//
+// The header count is the durable size. flush() first syncs the elements and
+// only then publishes the count, so after a crash the file holds the
+// elements of the last flush. Destruction records the count without syncing,
+// which survives a process restart but not a power loss. While open, the file
+// is also readable through MappedVectorView.
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+class PersistentVector {
+private:
+    static_assert(sizeof(BinaryHeader) % alignof(T) == 0, "element alignment exceeds the header size");
+
+    ics_detail::FileDescriptor m_fd;
+    std::string m_path;
+    char* m_base;
+    size_t m_mapped;
+    size_t m_capacity;
+    size_t m_size;
+
+    static size_t page_size() noexcept {
+        return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    }
+
+    T* elements() const noexcept {
+        return reinterpret_cast<T*>(m_base + sizeof(BinaryHeader));
+    }
+
+    // Maps the first length bytes of the file in place of any earlier
+    // mapping, which stays in use if this one fails.
+    void map(size_t length) {
+        void* base = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd.get(), 0);
+        if (base == MAP_FAILED) {
+            throw VectorException("cannot map " + m_path);
+        }
+        unmap();
+        m_base = static_cast<char*>(base);
+        m_mapped = length;
+        m_capacity = (length - sizeof(BinaryHeader)) / sizeof(T);
+    }
+
+    void unmap() noexcept {
+        if (m_base != nullptr) {
+            ::munmap(m_base, m_mapped);
+            m_base = nullptr;
+            m_mapped = 0;
+        }
+    }
+
+    // Extends the file to hold new_capacity elements, rounded up to whole
+    // pages, and maps it again.
+    void grow(size_t new_capacity) {
+        size_t page = page_size();
+        size_t length = (sizeof(BinaryHeader) + new_capacity * sizeof(T) + page - 1) / page * page;
+        if (::ftruncate(m_fd.get(), static_cast<off_t>(length)) != 0) {
+            throw VectorException("cannot extend " + m_path);
+        }
+        map(length);
+    }
+
+    void write_count() noexcept {
+        if (m_base != nullptr) {
+            uint64_t count = m_size;
+            std::memcpy(m_base + offsetof(BinaryHeader, count), &count, sizeof(count));
+        }
+    }
+
+public:
+    // Opens path, creating an empty vector there if the file does not exist
+    // or is empty. The file must otherwise hold a binary vector of T.
+    explicit PersistentVector(const std::string& path, size_t initial_capacity = 0)
+        : m_fd(ics_detail::open_file(path, O_RDWR | O_CREAT)),
+          m_path(path),
+          m_base(nullptr),
+          m_mapped(0),
+          m_capacity(0),
+          m_size(0) {
+        size_t length = ics_detail::file_size(m_fd.get());
+        if (length == 0) {
+            BinaryHeader header = ics_detail::make_binary_header<T>(0);
+            ics_detail::write_all(m_fd.get(), &header, sizeof(header));
+            grow(initial_capacity > 0 ? initial_capacity : 1);
+            return;
+        }
+        if (length < sizeof(BinaryHeader)) {
+            throw VectorException("binary vector file " + path + " is truncated");
+        }
+        BinaryHeader header;
+        ics_detail::read_exact(m_fd.get(), &header, sizeof(header));
+        size_t count = ics_detail::check_binary_header<T>(header);
+        if (header.flags & BinaryHeader::flag_compressed) {
+            throw VectorException("compressed binary vector " + path + " cannot be mapped");
+        }
+        if ((length - sizeof(BinaryHeader)) / sizeof(T) < count) {
+            throw VectorException("binary vector file " + path + " is truncated");
+        }
+        m_size = count;
+        map(length);
+        if (initial_capacity > m_capacity) {
+            grow(initial_capacity);
+        }
+    }
+
+    PersistentVector(const PersistentVector&) = delete;
+    PersistentVector& operator=(const PersistentVector&) = delete;
+
+    PersistentVector(PersistentVector&& other) noexcept
+        : m_fd(std::move(other.m_fd)),
+          m_path(std::move(other.m_path)),
+          m_base(other.m_base),
+          m_mapped(other.m_mapped),
+          m_capacity(other.m_capacity),
+          m_size(other.m_size) {
+        other.m_base = nullptr;
+        other.m_mapped = 0;
+        other.m_capacity = 0;
+        other.m_size = 0;
+    }
+
+    PersistentVector& operator=(PersistentVector&& other) noexcept {
+        if (this != &other) {
+            write_count();
+            unmap();
+            m_fd = std::move(other.m_fd);
+            m_path = std::move(other.m_path);
+            m_base = other.m_base;
+            m_mapped = other.m_mapped;
+            m_capacity = other.m_capacity;
+            m_size = other.m_size;
+            other.m_base = nullptr;
+            other.m_mapped = 0;
+            other.m_capacity = 0;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+    ~PersistentVector() noexcept {
+        write_count();
+        unmap();
+    }
+
+    void push_back(const T& value) {
+        if (m_size >= m_capacity) {
+            grow(std::max<size_t>(1, m_capacity * 2));
+        }
+        elements()[m_size] = value;
+        ++m_size;
+    }
+
+    // Appends n elements with a single growth at most.
+    void append(const T* values, size_t n) {
+        if (m_size + n > m_capacity) {
+            grow(m_capacity * 2 > m_size + n ? m_capacity * 2 : m_size + n);
+        }
+        std::memcpy(elements() + m_size, values, n * sizeof(T));
+        m_size += n;
+    }
+
+    void pop_back() {
+        if (m_size == 0) {
+            throw VectorException("popping from empty");
+        }
+        --m_size;
+    }
+
+    void clear() noexcept {
+        m_size = 0;
+    }
+
+    void reserve(size_t new_capacity) {
+        if (new_capacity > m_capacity) {
+            grow(new_capacity);
+        }
+    }
+
+    // Syncs the elements to disk, then publishes the size in the header and
+    // syncs that too.
+    void flush() {
+        if (::msync(m_base, m_mapped, MS_SYNC) != 0) {
+            throw VectorException("cannot sync " + m_path);
+        }
+        write_count();
+        if (::msync(m_base, page_size(), MS_SYNC) != 0) {
+            throw VectorException("cannot sync " + m_path);
+        }
+    }
+
+    size_t size() const noexcept {
+        return m_size;
+    }
+
+    size_t capacity() const noexcept {
+        return m_capacity;
+    }
+
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    const std::string& path() const noexcept {
+        return m_path;
+    }
+
+    T* data() noexcept {
+        return elements();
+    }
+
+    const T* data() const noexcept {
+        return elements();
+    }
+
+    T* begin() noexcept {
+        return elements();
+    }
+
+    T* end() noexcept {
+        return elements() + m_size;
+    }
+
+    const T* begin() const noexcept {
+        return elements();
+    }
+
+    const T* end() const noexcept {
+        return elements() + m_size;
+    }
+
+    T& front() noexcept {
+        return elements()[0];
+    }
+
+    const T& front() const noexcept {
+        return elements()[0];
+    }
+
+    T& back() noexcept {
+        return elements()[m_size - 1];
+    }
+
+    const T& back() const noexcept {
+        return elements()[m_size - 1];
+    }
+
+    T& operator[](size_t index) noexcept {
+        return elements()[index];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return elements()[index];
+    }
+
+    T& at(size_t index) {
+        if (index >= m_size) {
+            throw VectorException("out of bounds");
+        }
+        return elements()[index];
+    }
+
+    const T& at(size_t index) const {
+        if (index >= m_size) {
+            throw VectorException("out of bounds");
+        }
+        return elements()[index];
+    }
+
+    bool operator==(const Vector<T>& other) const noexcept {
+        return m_size == other.size() && std::equal(begin(), end(), other.begin());
+    }
+
+    Vector<T> to_vector() const {
+        Vector<T> result;
+        std::memcpy(result.append_uninitialized(m_size), elements(), m_size * sizeof(T));
+        return result;
+    }
+};
+
+#endif
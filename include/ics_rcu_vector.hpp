@@ -0,0 +1,183 @@
+#ifndef ICS_RCU_VECTOR_HPP
+#define ICS_RCU_VECTOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "ics_thread_registry.hpp"
+#include "ics_vector.hpp"
+
+// Read-mostly Vector in the read-copy-update style. Readers take a
+// ReadGuard, which pins the current immutable version with two stores to
+// a thread-local slot and one pointer load: no locks after a thread's first
+// read and no writes to memory another reader touches. Writers, serialized by a mutex,
+// copy the current version, change the copy and publish it with one atomic
+// exchange.
+//
+// Old versions are reclaimed by epochs: a version retired in epoch e is
+// freed once no reader still inside a guard entered in epoch e or earlier.
+// A reader that stays inside a guard delays reclamation, never a writer.
+
+template <typename T>
+class RcuVector {
+private:
+    struct ReaderSlot {
+        std::atomic<uint64_t> epoch{0};  // 0 while outside every guard
+        unsigned depth = 0;              // nested guards on this thread
+    };
+
+    struct Retired {
+        const Vector<T>* version;
+        uint64_t epoch;
+    };
+
+    std::atomic<const Vector<T>*> m_current;
+    std::atomic<uint64_t> m_epoch;
+    mutable ics_detail::ThreadRegistry<ReaderSlot> m_readers;
+    std::mutex m_write_mutex;
+    Vector<Retired> m_retired;  // guarded by m_write_mutex
+
+    // Frees the retired versions no reader can still see.
+    void reclaim() {
+        uint64_t oldest = UINT64_MAX;
+        m_readers.for_each([&](ReaderSlot& slot) {
+            uint64_t epoch = slot.epoch.load();
+            if (epoch != 0 && epoch < oldest) {
+                oldest = epoch;
+            }
+        });
+        Vector<Retired> kept;
+        for (const Retired& retired : m_retired) {
+            if (retired.epoch < oldest) {
+                delete retired.version;
+            } else {
+                kept.push_back(retired);
+            }
+        }
+        m_retired = std::move(kept);
+    }
+
+    void publish(const Vector<T>* version) {
+        const Vector<T>* old = m_current.exchange(version);
+        m_retired.push_back(Retired{old, m_epoch.fetch_add(1)});
+        reclaim();
+    }
+
+public:
+    // Pins one version for as long as it lives. Keep guards short: every
+    // version retired meanwhile stays allocated until the guard goes away.
+    class ReadGuard {
+    private:
+        ReaderSlot* m_slot;
+        const Vector<T>* m_version;
+
+        friend class RcuVector;
+
+        ReadGuard(ReaderSlot& slot, const RcuVector& owner) noexcept : m_slot(&slot) {
+            if (m_slot->depth++ == 0) {
+                // seq_cst orders the slot store before the pointer load, so a
+                // writer scanning the slots either sees this epoch or has
+                // already published the version loaded below
+                m_slot->epoch.store(owner.m_epoch.load());
+            }
+            m_version = owner.m_current.load();
+        }
+
+    public:
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        ~ReadGuard() {
+            if (--m_slot->depth == 0) {
+                m_slot->epoch.store(0, std::memory_order_release);
+            }
+        }
+
+        const Vector<T>& operator*() const noexcept {
+            return *m_version;
+        }
+
+        const Vector<T>* operator->() const noexcept {
+            return m_version;
+        }
+
+        size_t size() const noexcept {
+            return m_version->size();
+        }
+
+        const T& operator[](size_t index) const noexcept {
+            return (*m_version)[index];
+        }
+    };
+
+    explicit RcuVector(Vector<T> values = Vector<T>())
+        : m_current(new Vector<T>(std::move(values))), m_epoch(1) {}
+
+    RcuVector(const RcuVector&) = delete;
+    RcuVector& operator=(const RcuVector&) = delete;
+
+    // No reader may hold a guard any more.
+    ~RcuVector() {
+        for (const Retired& retired : m_retired) {
+            delete retired.version;
+        }
+        delete m_current.load();
+    }
+
+    ReadGuard read() const {
+        return ReadGuard(m_readers.local(), *this);
+    }
+
+    // A copy of the current version.
+    Vector<T> load() const {
+        ReadGuard guard = read();
+        return *guard;
+    }
+
+    // Publishes f applied to a copy of the current version.
+    template <typename F>
+    void update(F&& f) {
+        std::lock_guard<std::mutex> lock(m_write_mutex);
+        Vector<T>* next = new Vector<T>(*m_current.load());
+        try {
+            f(*next);
+        } catch (...) {
+            delete next;
+            throw;
+        }
+        publish(next);
+    }
+
+    // Publishes a replacement without copying the current version.
+    void store(Vector<T> values) {
+        std::lock_guard<std::mutex> lock(m_write_mutex);
+        publish(new Vector<T>(std::move(values)));
+    }
+
+    // Versions retired but not yet freed.
+    size_t retired() {
+        std::lock_guard<std::mutex> lock(m_write_mutex);
+        return m_retired.size();
+    }
+
+    // Waits until every retired version has been freed, that is until every
+    // reader that could see one has left its guard. The calling thread must
+    // not hold a guard itself.
+    void synchronize() {
+        std::unique_lock<std::mutex> lock(m_write_mutex);
+        while (true) {
+            reclaim();
+            if (m_retired.empty()) {
+                return;
+            }
+            lock.unlock();
+            std::this_thread::yield();
+            lock.lock();
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,233 @@
+#ifndef ICS_RLE_VECTOR_HPP
+#define ICS_RLE_VECTOR_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "ics_vector.hpp"
+#include "vector_exception.hpp"
+
+// Run-length-encoded vector. Consecutive equal elements are stored as one run
+// (value, end offset); random access binary-searches the run end offsets and
+// aggregations visit each run once instead of each element.
+template <typename T>
+class RleVector {
+private:
+    Vector<T> m_values;
+    Vector<size_t> m_ends;
+
+public:
+    struct Run {
+        const T& value;
+        size_t start;
+        size_t length;
+    };
+
+    class ConstIterator {
+    private:
+        const RleVector* m_container;
+        size_t m_run;
+        size_t m_index;
+
+    public:
+        ConstIterator(const RleVector* container, size_t run, size_t index)
+            : m_container(container), m_run(run), m_index(index) {}
+
+        const T& operator*() const noexcept {
+            return m_container->m_values[m_run];
+        }
+
+        ConstIterator& operator++() noexcept {
+            ++m_index;
+            if (m_index == m_container->m_ends[m_run]) {
+                ++m_run;
+            }
+            return *this;
+        }
+
+        bool operator==(const ConstIterator& other) const noexcept {
+            return m_container == other.m_container && m_index == other.m_index;
+        }
+
+        bool operator!=(const ConstIterator& other) const noexcept {
+            return !(*this == other);
+        }
+    };
+
+    RleVector() noexcept = default;
+
+    explicit RleVector(const Vector<T>& values) {
+        for (const T& value : values) {
+            push_back(value);
+        }
+    }
+
+    void push_back(const T& value) {
+        append(value, 1);
+    }
+
+    // Appends count copies of value, extending the last run when it matches.
+    void append(const T& value, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        if (!m_values.empty() && m_values.back() == value) {
+            m_ends.back() += count;
+            return;
+        }
+        m_values.push_back(value);
+        m_ends.push_back(size() + count);
+    }
+
+    void pop_back() {
+        if (empty()) {
+            throw VectorException("popping from empty");
+        }
+        size_t start = m_ends.size() > 1 ? m_ends[m_ends.size() - 2] : 0;
+        if (--m_ends.back() == start) {
+            m_ends.pop_back();
+            m_values.pop_back();
+        }
+    }
+
+    // Index of the run holding element index.
+    size_t run_index(size_t index) const noexcept {
+        size_t lo = 0;
+        size_t hi = m_ends.size();
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (m_ends[mid] <= index) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return m_values[run_index(index)];
+    }
+
+    const T& at(size_t index) const {
+        if (index >= size()) {
+            throw VectorException("out of bounds");
+        }
+        return (*this)[index];
+    }
+
+    const T& front() const noexcept {
+        return m_values.front();
+    }
+
+    const T& back() const noexcept {
+        return m_values.back();
+    }
+
+    size_t size() const noexcept {
+        return m_ends.empty() ? 0 : m_ends.back();
+    }
+
+    bool empty() const noexcept {
+        return m_ends.empty();
+    }
+
+    size_t run_count() const noexcept {
+        return m_values.size();
+    }
+
+    Run run(size_t k) const noexcept {
+        size_t start = k > 0 ? m_ends[k - 1] : 0;
+        return Run{m_values[k], start, m_ends[k] - start};
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, m_values.size(), size());
+    }
+
+    // Calls f(value, length) once per run.
+    template <typename F>
+    void for_each_run(F&& f) const {
+        size_t start = 0;
+        for (size_t k = 0; k < m_values.size(); ++k) {
+            f(m_values[k], m_ends[k] - start);
+            start = m_ends[k];
+        }
+    }
+
+    // Folds runs with acc = f(acc, value, length).
+    template <typename Acc, typename F>
+    Acc reduce_runs(Acc init, F&& f) const {
+        for_each_run([&](const T& value, size_t length) {
+            init = f(std::move(init), value, length);
+        });
+        return init;
+    }
+
+    T sum() const requires std::is_arithmetic_v<T> {
+        return reduce_runs(T{}, [](T acc, const T& value, size_t length) {
+            return static_cast<T>(acc + value * static_cast<T>(length));
+        });
+    }
+
+    size_t count(const T& value) const {
+        return reduce_runs(size_t{0}, [&value](size_t acc, const T& run_value, size_t length) {
+            return run_value == value ? acc + length : acc;
+        });
+    }
+
+    const T& min() const {
+        if (empty()) {
+            throw VectorException("min of empty");
+        }
+        size_t best = 0;
+        for (size_t k = 1; k < m_values.size(); ++k) {
+            if (m_values[k] < m_values[best]) {
+                best = k;
+            }
+        }
+        return m_values[best];
+    }
+
+    const T& max() const {
+        if (empty()) {
+            throw VectorException("max of empty");
+        }
+        size_t best = 0;
+        for (size_t k = 1; k < m_values.size(); ++k) {
+            if (m_values[best] < m_values[k]) {
+                best = k;
+            }
+        }
+        return m_values[best];
+    }
+
+    Vector<T> to_vector() const {
+        Vector<T> result(size());
+        for_each_run([&result](const T& value, size_t length) {
+            for (size_t i = 0; i < length; ++i) {
+                result.push_back(value);
+            }
+        });
+        return result;
+    }
+
+    void clear() noexcept {
+        m_values.clear();
+        m_ends.clear();
+    }
+
+    bool operator==(const RleVector& other) const noexcept {
+        return m_ends == other.m_ends && m_values == other.m_values;
+    }
+
+    bool operator!=(const RleVector& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+#endif
@@ -0,0 +1,540 @@
+#ifndef ICS_RRB_VECTOR_HPP
+#define ICS_RRB_VECTOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include "ics_vector.hpp"
+#include "vector_exception.hpp"
+
+// Immutable vector as a relaxed radix balanced (RRB) tree. push_back, set
+// and slicing return a new version that shares all untouched nodes with the
+// old one, copying only the O(log32 n) nodes on one root-to-leaf path.
+//
+// Leaves hold up to 32 elements and inner nodes up to 32 children. A
+// balanced inner node has every child but the last completely full, so the
+// child holding an index is found by shifting; slicing off a prefix leaves
+// partial nodes behind, and their parents become relaxed nodes that keep a
+// table of cumulative child sizes. The last leaf is kept out of the tree as
+// the tail, so most appends touch only the tail.
+//
+// Transient is a mutable builder over a version: nodes it has copied carry
+// its owner id and are edited in place until persistent() hands them out.
+
+namespace ics_detail {
+    inline constexpr unsigned rrb_bits = 5;
+    inline constexpr size_t rrb_branching = size_t{1} << rrb_bits;
+
+    inline uint64_t next_rrb_owner() noexcept {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    template <typename T>
+    struct RrbNode {
+        Vector<T> values;                          // leaves only
+        Vector<std::shared_ptr<RrbNode>> children;  // inner nodes only
+        Vector<size_t> sizes;                       // cumulative, relaxed nodes only
+        uint64_t owner = 0;                         // transient allowed to edit in place
+    };
+}
+
+template <typename T>
+class RrbVector {
+private:
+    using Node = ics_detail::RrbNode<T>;
+    using NodePtr = std::shared_ptr<Node>;
+    static constexpr unsigned bits = ics_detail::rrb_bits;
+    static constexpr size_t branching = ics_detail::rrb_branching;
+
+    NodePtr m_root;    // null while every element fits in the tail
+    NodePtr m_tail;
+    unsigned m_shift;  // the root's children hold 1 << m_shift elements each
+    size_t m_size;
+
+    static NodePtr make_node(uint64_t owner) {
+        NodePtr node = std::make_shared<Node>();
+        node->owner = owner;
+        return node;
+    }
+
+    static NodePtr make_leaf(uint64_t owner) {
+        NodePtr leaf = make_node(owner);
+        leaf->values = Vector<T>(branching);
+        return leaf;
+    }
+
+    // node itself if owner may edit it, otherwise a copy owner may edit.
+    static NodePtr editable(const NodePtr& node, uint64_t owner) {
+        if (owner != 0 && node->owner == owner) {
+            return node;
+        }
+        NodePtr copy = std::make_shared<Node>(*node);
+        copy->owner = owner;
+        return copy;
+    }
+
+    static size_t node_size(const Node& node, unsigned shift) noexcept {
+        if (shift == 0) {
+            return node.values.size();
+        }
+        if (!node.sizes.empty()) {
+            return node.sizes[node.sizes.size() - 1];
+        }
+        size_t last = node.children.size() - 1;
+        return (last << shift) + node_size(*node.children[last], shift - bits);
+    }
+
+    static size_t child_size(const Node& node, unsigned shift, size_t index) noexcept {
+        if (!node.sizes.empty()) {
+            return node.sizes[index] - (index > 0 ? node.sizes[index - 1] : 0);
+        }
+        if (index + 1 < node.children.size()) {
+            return size_t{1} << shift;
+        }
+        return node_size(*node.children[index], shift - bits);
+    }
+
+    // Child of an inner node holding index; index becomes relative to it.
+    static size_t child_index(const Node& node, unsigned shift, size_t& index) noexcept {
+        size_t slot = index >> shift;
+        if (node.sizes.empty()) {
+            index -= slot << shift;
+            return slot;
+        }
+        // no child holds more than 1 << shift, so the radix guess is a lower bound
+        while (node.sizes[slot] <= index) {
+            ++slot;
+        }
+        if (slot > 0) {
+            index -= node.sizes[slot - 1];
+        }
+        return slot;
+    }
+
+    size_t tail_offset() const noexcept {
+        return m_size - m_tail->values.size();
+    }
+
+    const Node* leaf_for(size_t index, size_t& leaf_start) const noexcept {
+        size_t offset = tail_offset();
+        if (index >= offset) {
+            leaf_start = offset;
+            return m_tail.get();
+        }
+        size_t relative = index;
+        const Node* node = m_root.get();
+        for (unsigned shift = m_shift; shift > 0; shift -= bits) {
+            node = node->children[child_index(*node, shift, relative)].get();
+        }
+        leaf_start = index - relative;
+        return node;
+    }
+
+    static NodePtr new_path(unsigned shift, const NodePtr& leaf, uint64_t owner) {
+        if (shift == 0) {
+            return leaf;
+        }
+        NodePtr node = make_node(owner);
+        node->children.push_back(new_path(shift - bits, leaf, owner));
+        return node;
+    }
+
+    // Appends child to an inner node, relaxing it if the current last child
+    // is not full.
+    static void append_child(Node& node, unsigned shift, NodePtr child, size_t size) {
+        size_t count = node.children.size();
+        if (node.sizes.empty()) {
+            size_t last_size = node_size(*node.children[count - 1], shift - bits);
+            if (last_size != size_t{1} << shift) {
+                node.sizes = Vector<size_t>(branching);
+                for (size_t j = 0; j + 1 < count; ++j) {
+                    node.sizes.push_back((j + 1) << shift);
+                }
+                node.sizes.push_back(((count - 1) << shift) + last_size);
+            }
+        }
+        node.children.push_back(std::move(child));
+        if (!node.sizes.empty()) {
+            node.sizes.push_back(node.sizes[count - 1] + size);
+        }
+    }
+
+    // Adds leaf at the right edge of the subtree, or returns null when the
+    // subtree has no room left.
+    static NodePtr push_leaf(const NodePtr& node, unsigned shift, const NodePtr& leaf, uint64_t owner) {
+        size_t count = node->children.size();
+        size_t leaf_size = leaf->values.size();
+        if (shift > bits) {
+            NodePtr child = push_leaf(node->children[count - 1], shift - bits, leaf, owner);
+            if (child) {
+                NodePtr copy = editable(node, owner);
+                copy->children[count - 1] = std::move(child);
+                if (!copy->sizes.empty()) {
+                    copy->sizes[count - 1] += leaf_size;
+                }
+                return copy;
+            }
+        }
+        if (count == branching) {
+            return nullptr;
+        }
+        NodePtr copy = editable(node, owner);
+        append_child(*copy, shift, new_path(shift - bits, leaf, owner), leaf_size);
+        return copy;
+    }
+
+    void push_tail(uint64_t owner) {
+        if (!m_root) {
+            m_root = new_path(bits, m_tail, owner);
+            m_shift = bits;
+            return;
+        }
+        if (NodePtr pushed = push_leaf(m_root, m_shift, m_tail, owner)) {
+            m_root = std::move(pushed);
+            return;
+        }
+        size_t old_size = node_size(*m_root, m_shift);
+        NodePtr root = make_node(owner);
+        root->children.push_back(m_root);
+        root->children.push_back(new_path(m_shift, m_tail, owner));
+        if (old_size != size_t{1} << (m_shift + bits)) {
+            root->sizes.push_back(old_size);
+            root->sizes.push_back(old_size + m_tail->values.size());
+        }
+        m_root = std::move(root);
+        m_shift += bits;
+    }
+
+    void push_back_in_place(const T& value, uint64_t owner) {
+        if (m_tail->values.size() == branching) {
+            push_tail(owner);
+            m_tail = make_leaf(owner);
+        } else {
+            m_tail = editable(m_tail, owner);
+        }
+        m_tail->values.push_back(value);
+        ++m_size;
+    }
+
+    static NodePtr set_in(const NodePtr& node, unsigned shift, size_t index, const T& value, uint64_t owner) {
+        NodePtr copy = editable(node, owner);
+        if (shift == 0) {
+            copy->values[index] = value;
+            return copy;
+        }
+        size_t slot = child_index(*copy, shift, index);
+        copy->children[slot] = set_in(copy->children[slot], shift - bits, index, value, owner);
+        return copy;
+    }
+
+    void set_in_place(size_t index, const T& value, uint64_t owner) {
+        if (index >= m_size) {
+            throw VectorException("out of bounds");
+        }
+        size_t offset = tail_offset();
+        if (index >= offset) {
+            m_tail = editable(m_tail, owner);
+            m_tail->values[index - offset] = value;
+        } else {
+            m_root = set_in(m_root, m_shift, index, value, owner);
+        }
+    }
+
+    static NodePtr leaf_slice(const Node& leaf, size_t first, size_t last) {
+        NodePtr slice = make_leaf(0);
+        for (size_t i = first; i < last; ++i) {
+            slice->values.push_back(leaf.values[i]);
+        }
+        return slice;
+    }
+
+    // First count elements of a subtree, count > 0.
+    static NodePtr truncate(const NodePtr& node, unsigned shift, size_t count) {
+        if (shift == 0) {
+            return count == node->values.size() ? node : leaf_slice(*node, 0, count);
+        }
+        size_t relative = count - 1;
+        size_t slot = child_index(*node, shift, relative);
+        NodePtr copy = make_node(0);
+        for (size_t j = 0; j < slot; ++j) {
+            copy->children.push_back(node->children[j]);
+            if (!node->sizes.empty()) {
+                copy->sizes.push_back(node->sizes[j]);
+            }
+        }
+        copy->children.push_back(truncate(node->children[slot], shift - bits, relative + 1));
+        if (!node->sizes.empty()) {
+            copy->sizes.push_back(count);
+        }
+        return copy;
+    }
+
+    // The subtree without its first n elements, n below its size. The
+    // result's first child is partial, so it is always relaxed.
+    static NodePtr drop_front(const NodePtr& node, unsigned shift, size_t n) {
+        if (n == 0) {
+            return node;
+        }
+        if (shift == 0) {
+            return leaf_slice(*node, n, node->values.size());
+        }
+        size_t relative = n;
+        size_t slot = child_index(*node, shift, relative);
+        NodePtr copy = make_node(0);
+        NodePtr first = drop_front(node->children[slot], shift - bits, relative);
+        size_t total = node_size(*first, shift - bits);
+        copy->children.push_back(std::move(first));
+        copy->sizes.push_back(total);
+        for (size_t j = slot + 1; j < node->children.size(); ++j) {
+            copy->children.push_back(node->children[j]);
+            total += child_size(*node, shift, j);
+            copy->sizes.push_back(total);
+        }
+        return copy;
+    }
+
+    void collapse_root() {
+        while (m_shift > bits && m_root->children.size() == 1) {
+            NodePtr child = m_root->children[0];
+            m_root = std::move(child);
+            m_shift -= bits;
+        }
+    }
+
+public:
+    class Transient;
+
+    class ConstIterator {
+    private:
+        const RrbVector* m_vector;
+        size_t m_index;
+        mutable const T* m_leaf;
+        mutable size_t m_leaf_start;
+        mutable size_t m_leaf_end;
+
+    public:
+        ConstIterator(const RrbVector* vector, size_t index) noexcept
+            : m_vector(vector), m_index(index), m_leaf(nullptr), m_leaf_start(0), m_leaf_end(0) {}
+
+        const T& operator*() const noexcept {
+            if (m_index < m_leaf_start || m_index >= m_leaf_end) {
+                const Node* leaf = m_vector->leaf_for(m_index, m_leaf_start);
+                m_leaf = leaf->values.data();
+                m_leaf_end = m_leaf_start + leaf->values.size();
+            }
+            return m_leaf[m_index - m_leaf_start];
+        }
+
+        ConstIterator& operator++() noexcept {
+            ++m_index;
+            return *this;
+        }
+
+        bool operator==(const ConstIterator& other) const noexcept {
+            return m_index == other.m_index;
+        }
+    };
+
+    RrbVector() : m_root(nullptr), m_tail(make_leaf(0)), m_shift(bits), m_size(0) {}
+
+    explicit RrbVector(const Vector<T>& values) : RrbVector() {
+        uint64_t owner = ics_detail::next_rrb_owner();
+        for (const T& value : values) {
+            push_back_in_place(value, owner);
+        }
+    }
+
+    size_t size() const noexcept {
+        return m_size;
+    }
+
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        size_t leaf_start;
+        const Node* leaf = leaf_for(index, leaf_start);
+        return leaf->values[index - leaf_start];
+    }
+
+    const T& at(size_t index) const {
+        if (index >= m_size) {
+            throw VectorException("out of bounds");
+        }
+        return (*this)[index];
+    }
+
+    const T& front() const noexcept {
+        return (*this)[0];
+    }
+
+    const T& back() const noexcept {
+        return (*this)[m_size - 1];
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, m_size);
+    }
+
+    [[nodiscard]] RrbVector push_back(const T& value) const {
+        RrbVector result = *this;
+        result.push_back_in_place(value, 0);
+        return result;
+    }
+
+    [[nodiscard]] RrbVector set(size_t index, const T& value) const {
+        RrbVector result = *this;
+        result.set_in_place(index, value, 0);
+        return result;
+    }
+
+    [[nodiscard]] RrbVector pop_back() const {
+        if (m_size == 0) {
+            throw VectorException("popping from empty");
+        }
+        return take(m_size - 1);
+    }
+
+    // The first n elements.
+    [[nodiscard]] RrbVector take(size_t n) const {
+        if (n >= m_size) {
+            return *this;
+        }
+        RrbVector result;
+        if (n == 0) {
+            return result;
+        }
+        size_t offset = tail_offset();
+        if (n > offset) {
+            result = *this;
+            result.m_tail = leaf_slice(*m_tail, 0, n - offset);
+            result.m_size = n;
+            return result;
+        }
+        // the leaf holding the new last element becomes the tail
+        size_t leaf_start;
+        const Node* leaf = leaf_for(n - 1, leaf_start);
+        result.m_tail = leaf_slice(*leaf, 0, n - leaf_start);
+        result.m_size = n;
+        if (leaf_start > 0) {
+            result.m_root = truncate(m_root, m_shift, leaf_start);
+            result.m_shift = m_shift;
+            result.collapse_root();
+        }
+        return result;
+    }
+
+    // Everything after the first n elements.
+    [[nodiscard]] RrbVector drop(size_t n) const {
+        if (n == 0) {
+            return *this;
+        }
+        RrbVector result;
+        if (n >= m_size) {
+            return result;
+        }
+        size_t offset = tail_offset();
+        result.m_size = m_size - n;
+        if (n >= offset) {
+            result.m_tail = leaf_slice(*m_tail, n - offset, m_tail->values.size());
+            return result;
+        }
+        result.m_tail = m_tail;
+        result.m_root = drop_front(m_root, m_shift, n);
+        result.m_shift = m_shift;
+        result.collapse_root();
+        return result;
+    }
+
+    // Elements [first, last).
+    [[nodiscard]] RrbVector slice(size_t first, size_t last) const {
+        if (first > last || last > m_size) {
+            throw VectorException("out of bounds");
+        }
+        return take(last).drop(first);
+    }
+
+    Transient transient() const {
+        return Transient(*this);
+    }
+
+    Vector<T> to_vector() const {
+        Vector<T> result(m_size);
+        for (const T& value : *this) {
+            result.push_back(value);
+        }
+        return result;
+    }
+
+    bool operator==(const RrbVector& other) const {
+        if (m_size != other.m_size) {
+            return false;
+        }
+        ConstIterator theirs = other.begin();
+        for (const T& value : *this) {
+            if (!(value == *theirs)) {
+                return false;
+            }
+            ++theirs;
+        }
+        return true;
+    }
+
+    bool operator==(const Vector<T>& other) const {
+        if (m_size != other.size()) {
+            return false;
+        }
+        size_t i = 0;
+        for (const T& value : *this) {
+            if (!(value == other[i++])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Mutable builder: edits nodes it already owns in place, so a batch of
+    // pushes or sets costs about as much as on a Vector.
+    class Transient {
+    private:
+        RrbVector m_vector;
+        uint64_t m_owner;
+
+    public:
+        explicit Transient(RrbVector vector = RrbVector())
+            : m_vector(std::move(vector)), m_owner(ics_detail::next_rrb_owner()) {}
+
+        void push_back(const T& value) {
+            m_vector.push_back_in_place(value, m_owner);
+        }
+
+        void set(size_t index, const T& value) {
+            m_vector.set_in_place(index, value, m_owner);
+        }
+
+        size_t size() const noexcept {
+            return m_vector.size();
+        }
+
+        const T& operator[](size_t index) const noexcept {
+            return m_vector[index];
+        }
+
+        // Freezes the current contents as a version. The builder stays usable
+        // but no longer edits the nodes that version shares.
+        RrbVector persistent() {
+            m_owner = ics_detail::next_rrb_owner();
+            return m_vector;
+        }
+    };
+};
+
+#endif
@@ -0,0 +1,429 @@
+#ifndef ICS_SHARED_VECTOR_HPP
+#define ICS_SHARED_VECTOR_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "ics_file.hpp"
+#include "ics_vector.hpp"
+#include "ics_vector_io.hpp"
+#include "vector_exception.hpp"
+
+// Append-only Vector in a named POSIX shared-memory segment. One process
+// creates it with SharedVector and appends; others attach with
+// SharedVectorReader and read the elements in place, without copying.
+//
+// The segment starts with a SharedVectorControl block that holds only
+// offsets and counts, never pointers, so every process can map it at a
+// different address. The writer stores elements first and then publishes
+// the new size with a release store; a reader's acquire load of the size
+// makes those elements visible. The state word carries the handshake: a
+// segment becomes `ready` once initialized and `sealed` when the writer is
+// done appending.
+
+struct SharedVectorControl {
+    static constexpr char magic_bytes[4] = {'I', 'C', 'S', 'M'};
+    static constexpr uint16_t current_version = 1;
+    static constexpr uint32_t state_creating = 0;
+    static constexpr uint32_t state_ready = 1;
+    static constexpr uint32_t state_sealed = 2;
+    static constexpr size_t data_offset = 64;
+
+    char magic[4];
+    uint16_t version;
+    uint8_t type_tag;
+    uint8_t flags;
+    uint32_t element_size;
+    std::atomic<uint32_t> state;
+    std::atomic<uint32_t> readers;  // readers attached so far
+    std::atomic<uint64_t> capacity;
+    std::atomic<uint64_t> size;
+};
+
+static_assert(sizeof(SharedVectorControl) <= SharedVectorControl::data_offset);
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+              "shared-memory atomics must be lock-free");
+
+namespace ics_detail {
+    inline FileDescriptor open_shared_memory(const std::string& name, int flags) {
+        int fd = ::shm_open(name.c_str(), flags, 0600);
+        if (fd < 0) {
+            throw VectorException("cannot open shared memory " + name);
+        }
+        return FileDescriptor(fd);
+    }
+
+    inline char* map_shared_memory(int fd, size_t length, int protection, const std::string& name) {
+        void* base = ::mmap(nullptr, length, protection, MAP_SHARED, fd, 0);
+        if (base == MAP_FAILED) {
+            throw VectorException("cannot map shared memory " + name);
+        }
+        return static_cast<char*>(base);
+    }
+
+    // Polls done() with a backoff from yielding up to 1ms sleeps until it
+    // returns true or timeout expires.
+    template <typename F>
+    bool poll_until(F done, std::chrono::milliseconds timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (int round = 0;; ++round) {
+            if (done()) {
+                return true;
+            }
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            if (round < 64) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(round < 1024 ? 50 : 1000));
+            }
+        }
+    }
+
+    template <typename T>
+    constexpr void check_shared_element() noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "shared-memory elements must be trivially copyable");
+        static_assert(alignof(T) <= SharedVectorControl::data_offset, "element alignment is too large");
+    }
+}
+
+// Writer side. Owns the segment's contents but not its name: the segment
+// outlives the writer until SharedVector<T>::remove(name) is called.
+template <typename T>
+class SharedVector {
+private:
+    ics_detail::FileDescriptor m_fd;
+    std::string m_name;
+    char* m_base;
+    size_t m_mapped;
+    size_t m_capacity;
+    size_t m_size;
+
+    SharedVectorControl* control() const noexcept {
+        return reinterpret_cast<SharedVectorControl*>(m_base);
+    }
+
+    T* elements() const noexcept {
+        return reinterpret_cast<T*>(m_base + SharedVectorControl::data_offset);
+    }
+
+    void grow(size_t new_capacity) {
+        size_t length = SharedVectorControl::data_offset + new_capacity * sizeof(T);
+        if (::ftruncate(m_fd.get(), static_cast<off_t>(length)) != 0) {
+            throw VectorException("cannot extend shared memory " + m_name);
+        }
+        char* base = ics_detail::map_shared_memory(m_fd.get(), length, PROT_READ | PROT_WRITE, m_name);
+        if (m_base != nullptr) {
+            ::munmap(m_base, m_mapped);
+        }
+        m_base = base;
+        m_mapped = length;
+        m_capacity = new_capacity;
+        control()->capacity.store(new_capacity, std::memory_order_release);
+    }
+
+    void publish() noexcept {
+        control()->size.store(m_size, std::memory_order_release);
+    }
+
+public:
+    // Creates the segment; fails if name already exists.
+    explicit SharedVector(const std::string& name, size_t initial_capacity = 1024)
+        : m_fd(ics_detail::open_shared_memory(name, O_RDWR | O_CREAT | O_EXCL)),
+          m_name(name),
+          m_base(nullptr),
+          m_mapped(0),
+          m_capacity(0),
+          m_size(0) {
+        ics_detail::check_shared_element<T>();
+        try {
+            grow(initial_capacity > 0 ? initial_capacity : 1);
+        } catch (...) {
+            ::shm_unlink(name.c_str());
+            throw;
+        }
+        BinaryHeader format = ics_detail::make_binary_header<T>(0);
+        SharedVectorControl* block = control();
+        std::memcpy(block->magic, SharedVectorControl::magic_bytes, sizeof(block->magic));
+        block->version = SharedVectorControl::current_version;
+        block->type_tag = format.type_tag;
+        block->flags = format.flags;
+        block->element_size = sizeof(T);
+        new (&block->state) std::atomic<uint32_t>(SharedVectorControl::state_creating);
+        new (&block->readers) std::atomic<uint32_t>(0);
+        new (&block->capacity) std::atomic<uint64_t>(m_capacity);
+        new (&block->size) std::atomic<uint64_t>(0);
+        block->state.store(SharedVectorControl::state_ready, std::memory_order_release);
+    }
+
+    SharedVector(const SharedVector&) = delete;
+    SharedVector& operator=(const SharedVector&) = delete;
+
+    SharedVector(SharedVector&& other) noexcept
+        : m_fd(std::move(other.m_fd)),
+          m_name(std::move(other.m_name)),
+          m_base(other.m_base),
+          m_mapped(other.m_mapped),
+          m_capacity(other.m_capacity),
+          m_size(other.m_size) {
+        other.m_base = nullptr;
+        other.m_mapped = 0;
+    }
+
+    SharedVector& operator=(SharedVector&& other) noexcept {
+        if (this != &other) {
+            if (m_base != nullptr) {
+                ::munmap(m_base, m_mapped);
+            }
+            m_fd = std::move(other.m_fd);
+            m_name = std::move(other.m_name);
+            m_base = other.m_base;
+            m_mapped = other.m_mapped;
+            m_capacity = other.m_capacity;
+            m_size = other.m_size;
+            other.m_base = nullptr;
+            other.m_mapped = 0;
+        }
+        return *this;
+    }
+
+    ~SharedVector() noexcept {
+        if (m_base != nullptr) {
+            ::munmap(m_base, m_mapped);
+        }
+    }
+
+    // Removes the segment name; mappings already made stay valid.
+    static void remove(const std::string& name) noexcept {
+        ::shm_unlink(name.c_str());
+    }
+
+    void push_back(const T& value) {
+        if (m_size >= m_capacity) {
+            grow(m_capacity * 2);
+        }
+        elements()[m_size] = value;
+        ++m_size;
+        publish();
+    }
+
+    // Appends n elements and publishes them with a single store.
+    void append(const T* values, size_t n) {
+        if (m_size + n > m_capacity) {
+            grow(m_capacity * 2 > m_size + n ? m_capacity * 2 : m_size + n);
+        }
+        std::memcpy(elements() + m_size, values, n * sizeof(T));
+        m_size += n;
+        publish();
+    }
+
+    // Marks the vector complete; readers waiting in wait_sealed return.
+    void seal() noexcept {
+        control()->state.store(SharedVectorControl::state_sealed, std::memory_order_release);
+    }
+
+    size_t readers() const noexcept {
+        return control()->readers.load(std::memory_order_acquire);
+    }
+
+    // Waits until at least count readers have attached.
+    bool wait_for_readers(size_t count, std::chrono::milliseconds timeout) const {
+        return ics_detail::poll_until([&] { return readers() >= count; }, timeout);
+    }
+
+    const std::string& name() const noexcept {
+        return m_name;
+    }
+
+    size_t size() const noexcept {
+        return m_size;
+    }
+
+    size_t capacity() const noexcept {
+        return m_capacity;
+    }
+
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    const T* data() const noexcept {
+        return elements();
+    }
+
+    const T* begin() const noexcept {
+        return elements();
+    }
+
+    const T* end() const noexcept {
+        return elements() + m_size;
+    }
+
+    // Elements are immutable once published.
+    const T& operator[](size_t index) const noexcept {
+        return elements()[index];
+    }
+
+    const T& at(size_t index) const {
+        if (index >= m_size) {
+            throw VectorException("out of bounds");
+        }
+        return elements()[index];
+    }
+};
+
+// Reader side. Works on a snapshot of the published size taken by the
+// constructor and refresh(); pointers stay valid until the next refresh(),
+// which may remap the segment after the writer has grown it.
+template <typename T>
+class SharedVectorReader {
+private:
+    ics_detail::FileDescriptor m_fd;
+    std::string m_name;
+    char* m_base;
+    size_t m_mapped;
+    size_t m_size;
+
+    SharedVectorControl* control() const noexcept {
+        return reinterpret_cast<SharedVectorControl*>(m_base);
+    }
+
+    const T* elements() const noexcept {
+        return reinterpret_cast<const T*>(m_base + SharedVectorControl::data_offset);
+    }
+
+    void unmap() noexcept {
+        if (m_base != nullptr) {
+            ::munmap(m_base, m_mapped);
+            m_base = nullptr;
+        }
+    }
+
+    void map_current_length() {
+        size_t length = ics_detail::file_size(m_fd.get());
+        // writable only so the reader can register in the control block
+        char* base = ics_detail::map_shared_memory(m_fd.get(), length, PROT_READ | PROT_WRITE, m_name);
+        unmap();
+        m_base = base;
+        m_mapped = length;
+    }
+
+    // Opens and validates the segment; false while the writer has not
+    // finished creating it.
+    bool try_attach() {
+        int fd = ::shm_open(m_name.c_str(), O_RDWR, 0);
+        if (fd < 0) {
+            return false;
+        }
+        m_fd = ics_detail::FileDescriptor(fd);
+        if (ics_detail::file_size(fd) < SharedVectorControl::data_offset) {
+            return false;
+        }
+        map_current_length();
+        if (control()->state.load(std::memory_order_acquire) == SharedVectorControl::state_creating) {
+            return false;
+        }
+        BinaryHeader format = ics_detail::make_binary_header<T>(0);
+        if (std::memcmp(control()->magic, SharedVectorControl::magic_bytes, sizeof(control()->magic)) != 0
+            || control()->version != SharedVectorControl::current_version) {
+            throw VectorException("shared memory " + m_name + " is not a shared vector");
+        }
+        if (control()->type_tag != format.type_tag || control()->flags != format.flags
+            || control()->element_size != sizeof(T)) {
+            throw VectorException("shared vector element type mismatch");
+        }
+        return true;
+    }
+
+public:
+    // Attaches to the segment name, waiting up to timeout for a writer to
+    // create it.
+    explicit SharedVectorReader(const std::string& name,
+                                std::chrono::milliseconds timeout = std::chrono::milliseconds(0))
+        : m_name(name), m_base(nullptr), m_mapped(0), m_size(0) {
+        ics_detail::check_shared_element<T>();
+        if (!ics_detail::poll_until([&] { return try_attach(); }, timeout)) {
+            unmap();
+            throw VectorException("shared vector " + name + " is not available");
+        }
+        control()->readers.fetch_add(1, std::memory_order_acq_rel);
+        refresh();
+    }
+
+    SharedVectorReader(const SharedVectorReader&) = delete;
+    SharedVectorReader& operator=(const SharedVectorReader&) = delete;
+
+    ~SharedVectorReader() noexcept {
+        unmap();
+    }
+
+    // Picks up elements published since the last call and returns the size.
+    size_t refresh() {
+        size_t published = static_cast<size_t>(control()->size.load(std::memory_order_acquire));
+        if (SharedVectorControl::data_offset + published * sizeof(T) > m_mapped) {
+            map_current_length();
+        }
+        m_size = published;
+        return m_size;
+    }
+
+    bool sealed() const noexcept {
+        return control()->state.load(std::memory_order_acquire) == SharedVectorControl::state_sealed;
+    }
+
+    // Waits for the writer to seal the vector, then refreshes.
+    bool wait_sealed(std::chrono::milliseconds timeout) {
+        if (!ics_detail::poll_until([&] { return sealed(); }, timeout)) {
+            return false;
+        }
+        refresh();
+        return true;
+    }
+
+    size_t size() const noexcept {
+        return m_size;
+    }
+
+    bool empty() const noexcept {
+        return m_size == 0;
+    }
+
+    const T* data() const noexcept {
+        return elements();
+    }
+
+    const T* begin() const noexcept {
+        return elements();
+    }
+
+    const T* end() const noexcept {
+        return elements() + m_size;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return elements()[index];
+    }
+
+    const T& at(size_t index) const {
+        if (index >= m_size) {
+            throw VectorException("out of bounds");
+        }
+        return elements()[index];
+    }
+
+    Vector<T> to_vector() const {
+        Vector<T> result;
+        std::memcpy(result.append_uninitialized(m_size), elements(), m_size * sizeof(T));
+        return result;
+    }
+};
+
+#endif
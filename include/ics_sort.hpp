@@ -0,0 +1,544 @@
+#ifndef ICS_SORT_HPP
+#define ICS_SORT_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "ics_parallel_algorithms.hpp"
+#include "ics_vector.hpp"
+
+// Sorting for Vectors, working on the element pointer rather than the
+// Vector iterator.
+//
+// sort and stable_sort with the default comparator on integral and
+// floating-point elements, and sort_by_key with such a key, use an LSD radix
+// sort: one histogram and one stable scatter per key byte, skipping bytes
+// every key shares. The chunks of each pass are counted and scattered in
+// parallel on the pool. Floats are ordered by their bits, so -0.0 comes
+// before +0.0 and NaNs go to the ends by sign.
+//
+// Other comparators go to a pattern-defeating quicksort (sort) or a merge
+// sort (stable_sort). Once a range holds more than one chunk of
+// ParallelOptions-sized work and the pool has several workers, both become a
+// parallel merge sort: chunks are sorted concurrently, then merged level by
+// level, each merge split further by binary search so large merges are
+// shared out too. Merges take the left element on ties, so they are stable.
+
+namespace ics_detail {
+    inline constexpr size_t sort_insertion_limit = 24;
+    inline constexpr size_t sort_ninther_limit = 128;
+    inline constexpr size_t merge_insertion_limit = 32;
+    inline constexpr size_t radix_min_size = 256;
+
+    template <typename K>
+    inline constexpr bool radix_key =
+        (std::is_integral_v<K> && !std::is_same_v<K, bool>) ||
+        (std::is_floating_point_v<K> && (sizeof(K) == 4 || sizeof(K) == 8));
+
+    template <typename Compare, typename T>
+    inline constexpr bool default_less = std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>;
+
+    // An unsigned integer whose order matches the order of key.
+    template <typename K>
+    auto ordered_bits(K key) noexcept {
+        if constexpr (std::is_floating_point_v<K>) {
+            using U = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+            constexpr U sign = U(1) << (sizeof(U) * 8 - 1);
+            U bits = std::bit_cast<U>(key);
+            return (bits & sign) != 0 ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+        } else if constexpr (std::is_signed_v<K>) {
+            using U = std::make_unsigned_t<K>;
+            return static_cast<U>(static_cast<U>(key) ^ (U(1) << (sizeof(U) * 8 - 1)));
+        } else {
+            return key;
+        }
+    }
+
+    // Stable LSD radix sort by the unsigned bits(element), a byte per pass.
+    template <typename T, typename Bits>
+    void radix_sort(Vector<T>& vec, Bits bits, const ParallelOptions& options) {
+        using U = std::decay_t<decltype(bits(vec[0]))>;
+        constexpr size_t passes = sizeof(U);
+        size_t n = vec.size();
+        // sorted input costs one read; anything else usually stops early
+        size_t ordered = 1;
+        while (ordered < n && !(bits(vec[ordered]) < bits(vec[ordered - 1]))) {
+            ++ordered;
+        }
+        if (ordered == n) {
+            return;
+        }
+        Vector<T> scratch = presized<T>(n);
+        ChunkPlan plan(n, sizeof(T), options);
+        // counts[chunk * 256 + digit], turned into output positions
+        Vector<size_t> counts = presized<size_t>(plan.count() * 256);
+        // one chunk sees the whole range, whose byte histograms do not
+        // change with the order: count them all in a single read
+        Vector<size_t> totals = presized<size_t>(plan.count() == 1 ? passes * 256 : 0);
+        if (plan.count() == 1) {
+            std::fill(&totals[0], &totals[0] + totals.size(), size_t{0});
+            for (size_t i = 0; i < n; ++i) {
+                U key = bits(vec[i]);
+                for (size_t pass = 0; pass < passes; ++pass) {
+                    ++totals[pass * 256 + ((key >> (pass * 8)) & 0xFF)];
+                }
+            }
+        }
+
+        T* from = &vec[0];
+        T* to = &scratch[0];
+        for (size_t pass = 0; pass < passes; ++pass) {
+            size_t shift = pass * 8;
+            if (plan.count() == 1) {
+                std::copy(&totals[pass * 256], &totals[pass * 256] + 256, &counts[0]);
+            } else {
+                plan.run([&](size_t chunk, size_t begin, size_t end) {
+                    size_t* histogram = &counts[chunk * 256];
+                    std::fill(histogram, histogram + 256, size_t{0});
+                    for (size_t i = begin; i < end; ++i) {
+                        ++histogram[(bits(from[i]) >> shift) & 0xFF];
+                    }
+                });
+            }
+            size_t position = 0;
+            bool shared_byte = false;
+            for (size_t digit = 0; digit < 256; ++digit) {
+                size_t total = 0;
+                for (size_t chunk = 0; chunk < plan.count(); ++chunk) {
+                    total += std::exchange(counts[chunk * 256 + digit], position + total);
+                }
+                position += total;
+                shared_byte = shared_byte || total == n;
+            }
+            if (shared_byte) {
+                continue;
+            }
+            plan.run([&](size_t chunk, size_t begin, size_t end) {
+                size_t* next = &counts[chunk * 256];
+                for (size_t i = begin; i < end; ++i) {
+                    to[next[(bits(from[i]) >> shift) & 0xFF]++] = std::move(from[i]);
+                }
+            });
+            std::swap(from, to);
+        }
+        if (from != &vec[0]) {
+            vec = std::move(scratch);
+        }
+    }
+
+    template <typename T, typename Compare>
+    void insertion_sort(T* first, T* last, Compare& comp) {
+        if (first == last) {
+            return;
+        }
+        for (T* current = first + 1; current != last; ++current) {
+            if (comp(*current, *(current - 1))) {
+                T moving = std::move(*current);
+                T* hole = current;
+                do {
+                    *hole = std::move(*(hole - 1));
+                    --hole;
+                } while (hole != first && comp(moving, *(hole - 1)));
+                *hole = std::move(moving);
+            }
+        }
+    }
+
+    // Insertion sort for a range with a lower bound at first[-1], so the
+    // inner loop needs no range check.
+    template <typename T, typename Compare>
+    void unguarded_insertion_sort(T* first, T* last, Compare& comp) {
+        for (T* current = first + 1; current < last; ++current) {
+            if (comp(*current, *(current - 1))) {
+                T moving = std::move(*current);
+                T* hole = current;
+                do {
+                    *hole = std::move(*(hole - 1));
+                    --hole;
+                } while (comp(moving, *(hole - 1)));
+                *hole = std::move(moving);
+            }
+        }
+    }
+
+    // Insertion sort that gives up once it has moved more than 8 elements;
+    // returns whether the range ended up sorted.
+    template <typename T, typename Compare>
+    bool partial_insertion_sort(T* first, T* last, Compare& comp) {
+        if (first == last) {
+            return true;
+        }
+        size_t moved = 0;
+        for (T* current = first + 1; current != last; ++current) {
+            if (comp(*current, *(current - 1))) {
+                T moving = std::move(*current);
+                T* hole = current;
+                do {
+                    *hole = std::move(*(hole - 1));
+                    --hole;
+                } while (hole != first && comp(moving, *(hole - 1)));
+                *hole = std::move(moving);
+                moved += static_cast<size_t>(current - hole);
+            }
+            if (moved > 8) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename T, typename Compare>
+    void sort3(T* a, T* b, T* c, Compare& comp) {
+        if (comp(*b, *a)) std::swap(*a, *b);
+        if (comp(*c, *b)) std::swap(*b, *c);
+        if (comp(*b, *a)) std::swap(*a, *b);
+    }
+
+    template <typename T, typename Compare>
+    void sift_down(T* heap, size_t size, size_t hole, Compare& comp) {
+        T moving = std::move(heap[hole]);
+        while (2 * hole + 1 < size) {
+            size_t child = 2 * hole + 1;
+            if (child + 1 < size && comp(heap[child], heap[child + 1])) {
+                ++child;
+            }
+            if (!comp(moving, heap[child])) {
+                break;
+            }
+            heap[hole] = std::move(heap[child]);
+            hole = child;
+        }
+        heap[hole] = std::move(moving);
+    }
+
+    template <typename T, typename Compare>
+    void heap_sort(T* first, T* last, Compare& comp) {
+        size_t size = static_cast<size_t>(last - first);
+        for (size_t i = size / 2; i-- > 0;) {
+            sift_down(first, size, i, comp);
+        }
+        for (size_t end = size; end-- > 1;) {
+            std::swap(first[0], first[end]);
+            sift_down(first, end, 0, comp);
+        }
+    }
+
+    // Partitions around the pivot *first: smaller elements to the left,
+    // the rest to the right. Returns the pivot's final place and whether
+    // the range was partitioned already.
+    template <typename T, typename Compare>
+    std::pair<T*, bool> partition_right(T* first, T* last, Compare& comp) {
+        T pivot = std::move(*first);
+        T* left = first;
+        T* right = last;
+        while (comp(*++left, pivot)) {
+        }
+        if (left - 1 == first) {
+            while (left < right && !comp(*--right, pivot)) {
+            }
+        } else {
+            while (!comp(*--right, pivot)) {
+            }
+        }
+        bool partitioned = left >= right;
+        while (left < right) {
+            std::swap(*left, *right);
+            while (comp(*++left, pivot)) {
+            }
+            while (!comp(*--right, pivot)) {
+            }
+        }
+        T* pivot_place = left - 1;
+        *first = std::move(*pivot_place);
+        *pivot_place = std::move(pivot);
+        return {pivot_place, partitioned};
+    }
+
+    // Partitions around *first with elements equal to the pivot on the
+    // left, for a pivot equal to the element before the range: the left
+    // part is then all equal and done.
+    template <typename T, typename Compare>
+    T* partition_left(T* first, T* last, Compare& comp) {
+        T pivot = std::move(*first);
+        T* left = first;
+        T* right = last;
+        while (comp(pivot, *--right)) {
+        }
+        if (right + 1 == last) {
+            while (left < right && !comp(pivot, *++left)) {
+            }
+        } else {
+            while (!comp(pivot, *++left)) {
+            }
+        }
+        while (left < right) {
+            std::swap(*left, *right);
+            while (comp(pivot, *--right)) {
+            }
+            while (!comp(pivot, *++left)) {
+            }
+        }
+        *first = std::move(*right);
+        *right = std::move(pivot);
+        return right;
+    }
+
+    // Breaks up patterns that made a partition lopsided by swapping a few
+    // elements near both ends of each side.
+    template <typename T>
+    void scatter_after_bad_partition(T* first, T* pivot_place, T* last) {
+        size_t left_size = static_cast<size_t>(pivot_place - first);
+        size_t right_size = static_cast<size_t>(last - (pivot_place + 1));
+        if (left_size >= sort_insertion_limit) {
+            size_t quarter = left_size / 4;
+            std::swap(first[0], first[quarter]);
+            std::swap(pivot_place[-1], pivot_place[-static_cast<ptrdiff_t>(quarter)]);
+            if (left_size > sort_ninther_limit) {
+                std::swap(first[1], first[quarter + 1]);
+                std::swap(first[2], first[quarter + 2]);
+                std::swap(pivot_place[-2], pivot_place[-static_cast<ptrdiff_t>(quarter + 1)]);
+                std::swap(pivot_place[-3], pivot_place[-static_cast<ptrdiff_t>(quarter + 2)]);
+            }
+        }
+        if (right_size >= sort_insertion_limit) {
+            size_t quarter = right_size / 4;
+            std::swap(pivot_place[1], pivot_place[1 + quarter]);
+            std::swap(last[-1], last[-static_cast<ptrdiff_t>(quarter)]);
+            if (right_size > sort_ninther_limit) {
+                std::swap(pivot_place[2], pivot_place[2 + quarter]);
+                std::swap(pivot_place[3], pivot_place[3 + quarter]);
+                std::swap(last[-2], last[-static_cast<ptrdiff_t>(quarter + 1)]);
+                std::swap(last[-3], last[-static_cast<ptrdiff_t>(quarter + 2)]);
+            }
+        }
+    }
+
+    // Pattern-defeating quicksort: median-of-3 (ninther for large ranges)
+    // pivots, a separate pass for runs of equal elements, an early exit for
+    // already sorted parts and heap sort after too many bad partitions.
+    template <typename T, typename Compare>
+    void pdqsort(T* first, T* last, Compare& comp, int bad_allowed, bool leftmost) {
+        while (true) {
+            size_t size = static_cast<size_t>(last - first);
+            if (size < sort_insertion_limit) {
+                if (leftmost) {
+                    insertion_sort(first, last, comp);
+                } else {
+                    unguarded_insertion_sort(first, last, comp);
+                }
+                return;
+            }
+            size_t half = size / 2;
+            if (size > sort_ninther_limit) {
+                sort3(first, first + half, last - 1, comp);
+                sort3(first + 1, first + (half - 1), last - 2, comp);
+                sort3(first + 2, first + (half + 1), last - 3, comp);
+                sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                std::swap(*first, *(first + half));
+            } else {
+                sort3(first + half, first, last - 1, comp);
+            }
+            if (!leftmost && !comp(*(first - 1), *first)) {
+                first = partition_left(first, last, comp) + 1;
+                continue;
+            }
+            auto [pivot_place, partitioned] = partition_right(first, last, comp);
+            size_t left_size = static_cast<size_t>(pivot_place - first);
+            size_t right_size = static_cast<size_t>(last - (pivot_place + 1));
+            if (left_size < size / 8 || right_size < size / 8) {
+                if (--bad_allowed == 0) {
+                    heap_sort(first, last, comp);
+                    return;
+                }
+                scatter_after_bad_partition(first, pivot_place, last);
+            } else if (partitioned && partial_insertion_sort(first, pivot_place, comp) &&
+                       partial_insertion_sort(pivot_place + 1, last, comp)) {
+                return;
+            }
+            pdqsort(first, pivot_place, comp, bad_allowed, leftmost);
+            first = pivot_place + 1;
+            leftmost = false;
+        }
+    }
+
+    template <typename T, typename Compare>
+    void pdqsort(T* first, T* last, Compare& comp) {
+        size_t size = static_cast<size_t>(last - first);
+        pdqsort(first, last, comp, static_cast<int>(std::bit_width(size)), true);
+    }
+
+    template <typename T, typename Compare>
+    void merge_into(T* left, size_t left_size, T* right, size_t right_size, T* out, Compare& comp) {
+        T* left_end = left + left_size;
+        T* right_end = right + right_size;
+        while (left != left_end && right != right_end) {
+            if (comp(*right, *left)) {
+                *out++ = std::move(*right++);
+            } else {
+                *out++ = std::move(*left++);
+            }
+        }
+        out = std::move(left, left_end, out);
+        std::move(right, right_end, out);
+    }
+
+    // How a merge sort is shared out: ranges up to chunk elements are
+    // sorted and merged serially.
+    struct MergePlan {
+        ThreadPool* pool;
+        size_t chunk;
+        bool stable;
+    };
+
+    // Merges two sorted runs into out, splitting at the middle of the
+    // longer run and the matching place in the other until the pieces fit
+    // in a chunk. Ties keep left elements first.
+    template <typename T, typename Compare>
+    void parallel_merge_into(T* left, size_t left_size, T* right, size_t right_size, T* out, Compare& comp,
+                             const MergePlan& plan) {
+        if (left_size + right_size <= plan.chunk || left_size == 0 || right_size == 0) {
+            merge_into(left, left_size, right, right_size, out, comp);
+            return;
+        }
+        size_t left_split = 0;
+        size_t right_split = 0;
+        if (left_size >= right_size) {
+            left_split = left_size / 2;
+            right_split = static_cast<size_t>(std::lower_bound(right, right + right_size, left[left_split], comp) - right);
+        } else {
+            right_split = right_size / 2;
+            left_split = static_cast<size_t>(std::upper_bound(left, left + left_size, right[right_split], comp) - left);
+        }
+        // two single elements already in order give an empty first piece
+        if (left_split + right_split == 0) {
+            merge_into(left, left_size, right, right_size, out, comp);
+            return;
+        }
+        parallel_invoke(
+            *plan.pool, [&] { parallel_merge_into(left, left_split, right, right_split, out, comp, plan); },
+            [&] {
+                parallel_merge_into(left + left_split, left_size - left_split, right + right_split,
+                                    right_size - right_split, out + left_split + right_split, comp, plan);
+            });
+    }
+
+    // Sorts data[0, n), leaving the result in data or, with into_buffer, in
+    // buffer[0, n); the other array is used as scratch. Each level merges
+    // from the array its halves were sorted into, so nothing is copied back.
+    template <typename T, typename Compare>
+    void merge_sort(T* data, T* buffer, size_t n, bool into_buffer, Compare& comp, const MergePlan* plan) {
+        bool serial_leaf = plan == nullptr && n <= merge_insertion_limit;
+        bool parallel_leaf = plan != nullptr && n <= plan->chunk;
+        if (serial_leaf || (parallel_leaf && !plan->stable)) {
+            if (serial_leaf) {
+                insertion_sort(data, data + n, comp);
+            } else {
+                pdqsort(data, data + n, comp);
+            }
+            if (into_buffer) {
+                std::move(data, data + n, buffer);
+            }
+            return;
+        }
+        if (parallel_leaf) {
+            merge_sort(data, buffer, n, into_buffer, comp, nullptr);
+            return;
+        }
+        size_t half = n / 2;
+        if (plan != nullptr) {
+            parallel_invoke(
+                *plan->pool, [&] { merge_sort(data, buffer, half, !into_buffer, comp, plan); },
+                [&] { merge_sort(data + half, buffer + half, n - half, !into_buffer, comp, plan); });
+        } else {
+            merge_sort(data, buffer, half, !into_buffer, comp, plan);
+            merge_sort(data + half, buffer + half, n - half, !into_buffer, comp, plan);
+        }
+        T* from = into_buffer ? data : buffer;
+        T* to = into_buffer ? buffer : data;
+        if (plan != nullptr) {
+            parallel_merge_into(from, half, from + half, n - half, to, comp, *plan);
+        } else {
+            merge_into(from, half, from + half, n - half, to, comp);
+        }
+    }
+
+    // Work per parallel leaf, as ChunkPlan sizes its chunks; 0 when the
+    // range is better sorted on the calling thread.
+    inline size_t sort_chunk(size_t n, size_t element_size, const ParallelOptions& options, ThreadPool& pool) {
+        if (pool.size() == 1) {
+            return 0;
+        }
+        size_t grain = options.grain != 0 ? options.grain : std::max<size_t>(1, min_chunk_bytes / element_size);
+        size_t target = pool.size() * chunks_per_worker;
+        size_t chunk = std::max(grain, (n + target - 1) / target);
+        return n > chunk ? chunk : 0;
+    }
+
+    template <typename T, typename Compare>
+    void comparison_sort(Vector<T>& vec, Compare& comp, bool stable, const ParallelOptions& options) {
+        size_t n = vec.size();
+        if (n < 2) {
+            return;
+        }
+        T* data = &vec[0];
+        ThreadPool& pool = options.pool != nullptr ? *options.pool : ThreadPool::global();
+        size_t chunk = sort_chunk(n, sizeof(T), options, pool);
+        if (chunk == 0 && !stable) {
+            pdqsort(data, data + n, comp);
+            return;
+        }
+        if (chunk == 0 && n <= merge_insertion_limit) {
+            insertion_sort(data, data + n, comp);
+            return;
+        }
+        Vector<T> buffer = presized<T>(n);
+        MergePlan plan{&pool, chunk, stable};
+        merge_sort(data, &buffer[0], n, false, comp, chunk == 0 ? nullptr : &plan);
+    }
+}
+
+// Sorts vec by comp. Not stable.
+template <typename T, typename Compare = std::less<>>
+void sort(Vector<T>& vec, Compare comp = {}, const ParallelOptions& options = {}) {
+    if constexpr (ics_detail::radix_key<T> && ics_detail::default_less<Compare, T>) {
+        if (vec.size() >= ics_detail::radix_min_size) {
+            ics_detail::radix_sort(vec, [](const T& value) { return ics_detail::ordered_bits(value); }, options);
+            return;
+        }
+    }
+    ics_detail::comparison_sort(vec, comp, false, options);
+}
+
+// Sorts vec by comp, keeping equal elements in their original order.
+template <typename T, typename Compare = std::less<>>
+void stable_sort(Vector<T>& vec, Compare comp = {}, const ParallelOptions& options = {}) {
+    if constexpr (ics_detail::radix_key<T> && ics_detail::default_less<Compare, T>) {
+        if (vec.size() >= ics_detail::radix_min_size) {
+            ics_detail::radix_sort(vec, [](const T& value) { return ics_detail::ordered_bits(value); }, options);
+            return;
+        }
+    }
+    ics_detail::comparison_sort(vec, comp, true, options);
+}
+
+// Stable sort by key(element) in ascending order. Integral and
+// floating-point keys are radix sorted, calling key once per element per
+// key byte, so it should be cheap and give the same answer every time.
+template <typename T, typename Key>
+void sort_by_key(Vector<T>& vec, Key key, const ParallelOptions& options = {}) {
+    using K = std::decay_t<std::invoke_result_t<Key&, const T&>>;
+    if constexpr (ics_detail::radix_key<K>) {
+        if (vec.size() >= ics_detail::radix_min_size) {
+            ics_detail::radix_sort(vec, [&](const T& value) { return ics_detail::ordered_bits(key(value)); }, options);
+            return;
+        }
+    }
+    auto by_key = [&](const T& a, const T& b) { return key(a) < key(b); };
+    ics_detail::comparison_sort(vec, by_key, true, options);
+}
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef ICS_SPSC_RING_HPP
+#define ICS_SPSC_RING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "ics_cache_line.hpp"
+#include "ics_vector.hpp"
+
+// Bounded lock-free queue between exactly one producer thread and one
+// consumer thread, over a Vector of power-of-two size. head and tail only
+// ever grow and are masked into slots. Each side owns one cache line with
+// its own index and its last seen copy of the other side's index, and
+// reloads the other index (a cross-core miss) only when the copy says the
+// ring is full or empty.
+//
+// Slots hold default-constructed T; push assigns into a slot and pop moves
+// out of it. push_n/pop_n move whole spans, with memcpy for trivially
+// copyable T, and publish them with a single store.
+
+template <typename T>
+    requires std::is_default_constructible_v<T>
+class SpscRing {
+private:
+    Vector<T> m_slots;
+    size_t m_mask;
+
+    // consumer side
+    alignas(ics_detail::cache_line_size) std::atomic<size_t> m_head;
+    size_t m_cached_tail;
+
+    // producer side
+    alignas(ics_detail::cache_line_size) std::atomic<size_t> m_tail;
+    size_t m_cached_head;
+
+    static Vector<T> make_slots(size_t capacity) {
+        Vector<T> slots(capacity);
+        for (size_t i = 0; i < capacity; ++i) {
+            slots.push_back(T());
+        }
+        return slots;
+    }
+
+    // Free slots as the producer sees them, reloading head if fewer than wanted.
+    size_t free_slots(size_t tail, size_t wanted) noexcept {
+        size_t free = capacity() - (tail - m_cached_head);
+        if (free < wanted) {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            free = capacity() - (tail - m_cached_head);
+        }
+        return free;
+    }
+
+    size_t ready_slots(size_t head, size_t wanted) noexcept {
+        size_t ready = m_cached_tail - head;
+        if (ready < wanted) {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            ready = m_cached_tail - head;
+        }
+        return ready;
+    }
+
+public:
+    // capacity is rounded up to a power of two.
+    explicit SpscRing(size_t capacity)
+        : m_slots(make_slots(std::bit_ceil(capacity > 1 ? capacity : 2))),
+          m_mask(m_slots.size() - 1),
+          m_head(0),
+          m_cached_tail(0),
+          m_tail(0),
+          m_cached_head(0) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const noexcept {
+        return m_mask + 1;
+    }
+
+    // Exact only when neither side is running.
+    size_t size() const noexcept {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    // Producer only. False if the ring is full.
+    template <typename U>
+    bool try_push(U&& value) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (free_slots(tail, 1) == 0) {
+            return false;
+        }
+        m_slots[tail & m_mask] = std::forward<U>(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only. False if the ring is empty.
+    bool try_pop(T& out) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (ready_slots(head, 1) == 0) {
+            return false;
+        }
+        out = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer only. Moves as many leading values as fit into the ring and
+    // returns how many.
+    size_t push_n(std::span<T> values) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t count = std::min(values.size(), free_slots(tail, values.size()));
+        size_t first = tail & m_mask;
+        size_t until_wrap = std::min(count, capacity() - first);
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memcpy(&m_slots[first], values.data(), until_wrap * sizeof(T));
+            std::memcpy(&m_slots[0], values.data() + until_wrap, (count - until_wrap) * sizeof(T));
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                m_slots[(tail + i) & m_mask] = std::move(values[i]);
+            }
+        }
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Consumer only. Moves up to out.size() values into out and returns how
+    // many.
+    size_t pop_n(std::span<T> out) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t count = std::min(out.size(), ready_slots(head, out.size()));
+        size_t first = head & m_mask;
+        size_t until_wrap = std::min(count, capacity() - first);
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            std::memcpy(out.data(), &m_slots[first], until_wrap * sizeof(T));
+            std::memcpy(out.data() + until_wrap, &m_slots[0], (count - until_wrap) * sizeof(T));
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = std::move(m_slots[(head + i) & m_mask]);
+            }
+        }
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+};
+
+#endif
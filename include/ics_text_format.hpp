@@ -0,0 +1,105 @@
+#ifndef ICS_TEXT_FORMAT_HPP
+#define ICS_TEXT_FORMAT_HPP
+
+#include <charconv>
+#include <cstddef>
+#include <locale>
+#include <ostream>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+// Element types formatted with std::to_chars instead of the stream. Character
+// types and bool are left out because streams print them as text.
+template <typename T>
+concept TextFormattable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>
+    && !std::is_same_v<T, char> && !std::is_same_v<T, signed char>
+    && !std::is_same_v<T, unsigned char> && !std::is_same_v<T, wchar_t>
+    && !std::is_same_v<T, char8_t> && !std::is_same_v<T, char16_t>
+    && !std::is_same_v<T, char32_t>;
+
+// Options for write_text. The defaults reproduce operator<< on a stream in
+// its initial state: every element followed by one space, floating point in
+// %g style with 6 significant digits.
+struct TextFormat {
+    std::string_view separator = " ";
+    bool trailing_separator = true;
+    // Significant digits for floating point, or -1 for the shortest text that
+    // reads back to the same value.
+    int precision = 6;
+    std::chars_format float_format = std::chars_format::general;
+};
+
+namespace ics_detail {
+    inline constexpr size_t text_chunk_size = size_t{64} << 10;
+
+    template <TextFormattable T>
+    std::to_chars_result format_number(char* first, char* last, T value, const TextFormat& format) {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (format.precision < 0) {
+                return std::to_chars(first, last, value, format.float_format);
+            }
+            return std::to_chars(first, last, value, format.float_format, format.precision);
+        } else {
+            return std::to_chars(first, last, value);
+        }
+    }
+
+    // True when os would format numbers exactly like to_chars: no manipulators
+    // beyond the defaults, no field width and the classic locale.
+    inline bool stream_is_plain(std::ostream& os) {
+        return os.flags() == (std::ios_base::skipws | std::ios_base::dec) && os.width() == 0
+            && os.getloc() == std::locale::classic();
+    }
+}
+
+// Formats n values into a local chunk that is handed to os in large writes.
+template <TextFormattable T>
+void write_text(std::ostream& os, const T* values, size_t n, const TextFormat& format = {}) {
+    char chunk[ics_detail::text_chunk_size];
+    char* const chunk_end = chunk + sizeof(chunk);
+    char* out = chunk;
+
+    auto flush = [&] {
+        os.write(chunk, out - chunk);
+        out = chunk;
+    };
+    auto append_separator = [&] {
+        if (static_cast<size_t>(chunk_end - out) < format.separator.size()) {
+            flush();
+            if (format.separator.size() > sizeof(chunk)) {
+                os.write(format.separator.data(), static_cast<std::streamsize>(format.separator.size()));
+                return;
+            }
+        }
+        for (char c : format.separator) {
+            *out++ = c;
+        }
+    };
+
+    for (size_t i = 0; i < n; ++i) {
+        std::to_chars_result result = ics_detail::format_number(out, chunk_end, values[i], format);
+        if (result.ec != std::errc()) {
+            flush();
+            result = ics_detail::format_number(out, chunk_end, values[i], format);
+        }
+        if (result.ec == std::errc()) {
+            out = result.ptr;
+        } else {
+            // only reachable with precisions too large for a whole chunk
+            os << values[i];
+        }
+        if (format.trailing_separator || i + 1 < n) {
+            append_separator();
+        }
+    }
+    flush();
+}
+
+template <typename Container>
+    requires TextFormattable<std::remove_cvref_t<decltype(*std::declval<const Container&>().data())>>
+void write_text(std::ostream& os, const Container& values, const TextFormat& format = {}) {
+    write_text(os, values.data(), values.size(), format);
+}
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef ICS_TEXT_PARSE_HPP
+#define ICS_TEXT_PARSE_HPP
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include "ics_file.hpp"
+#include "ics_text_format.hpp"
+#include "ics_vector.hpp"
+#include "vector_exception.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Parsing of whitespace- or comma-separated numbers, including the output of
+// operator<< and write_text.
+namespace ics_detail {
+    inline bool is_text_delimiter(char c) noexcept {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == ',';
+    }
+
+    // Counts tokens (maximal runs of non-delimiters) in text. The SSE2 path
+    // builds a 16-bit delimiter mask per block and counts positions where a
+    // non-delimiter follows a delimiter.
+    inline size_t count_text_tokens(std::string_view text) noexcept {
+        const char* p = text.data();
+        size_t n = text.size();
+        size_t count = 0;
+        size_t i = 0;
+        bool previous_delimiter = true;
+#if defined(__SSE2__)
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i newline = _mm_set1_epi8('\n');
+        const __m128i tab = _mm_set1_epi8('\t');
+        const __m128i carriage = _mm_set1_epi8('\r');
+        const __m128i comma = _mm_set1_epi8(',');
+        uint32_t carry = 1;
+        for (; i + 16 <= n; i += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            __m128i delimiters = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(block, space), _mm_cmpeq_epi8(block, newline)),
+                _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, tab), _mm_cmpeq_epi8(block, carriage)),
+                             _mm_cmpeq_epi8(block, comma)));
+            uint32_t delimiter_mask = static_cast<uint32_t>(_mm_movemask_epi8(delimiters));
+            uint32_t starts = ~delimiter_mask & ((delimiter_mask << 1) | carry) & 0xFFFF;
+            count += static_cast<size_t>(__builtin_popcount(starts));
+            carry = delimiter_mask >> 15;
+        }
+        previous_delimiter = carry != 0;
+#endif
+        for (; i < n; ++i) {
+            bool delimiter = is_text_delimiter(p[i]);
+            count += previous_delimiter && !delimiter;
+            previous_delimiter = delimiter;
+        }
+        return count;
+    }
+
+    template <TextFormattable T>
+    void reserve_text_tokens(Vector<T>& out, size_t extra) {
+        size_t needed = out.size() + extra;
+        if (needed > out.capacity()) {
+            out.resize(needed > 2 * out.capacity() ? needed : 2 * out.capacity());
+        }
+    }
+
+    [[noreturn]] inline void malformed_token(const char* first, const char* last) {
+        const char* end = first;
+        while (end < last && end - first < 32 && !is_text_delimiter(*end)) {
+            ++end;
+        }
+        throw VectorException("malformed number '" + std::string(first, end) + "'");
+    }
+
+    // Parses every token of text into out, which must already have room.
+    template <TextFormattable T>
+    size_t parse_tokens(Vector<T>& out, const char* p, const char* last) {
+        size_t parsed = 0;
+        while (true) {
+            while (p < last && is_text_delimiter(*p)) {
+                ++p;
+            }
+            if (p == last) {
+                return parsed;
+            }
+            T value;
+            std::from_chars_result result = std::from_chars(p, last, value);
+            if (result.ec != std::errc() || (result.ptr < last && !is_text_delimiter(*result.ptr))) {
+                malformed_token(p, last);
+            }
+            out.push_back(value);
+            ++parsed;
+            p = result.ptr;
+        }
+    }
+}
+
+// Appends the numbers in text to out and returns how many were read. A first
+// pass counts the tokens so out grows at most once.
+template <TextFormattable T>
+size_t parse_into(Vector<T>& out, std::string_view text) {
+    ics_detail::reserve_text_tokens(out, ics_detail::count_text_tokens(text));
+    return ics_detail::parse_tokens(out, text.data(), text.data() + text.size());
+}
+
+// Streaming variant of parse_into that reads fd in chunks of chunk_size bytes,
+// carrying a token split across chunks over to the next one.
+template <TextFormattable T>
+size_t parse_fd_into(Vector<T>& out, int fd, size_t chunk_size = size_t{1} << 20) {
+    Vector<char> buffer;
+    buffer.append_uninitialized(chunk_size);
+    size_t carried = 0;
+    size_t parsed = 0;
+    bool at_end = false;
+    while (!at_end) {
+        ssize_t got;
+        do {
+            got = ::read(fd, buffer.data() + carried, buffer.size() - carried);
+        } while (got < 0 && errno == EINTR);
+        if (got < 0) {
+            throw VectorException("read failed");
+        }
+        at_end = got == 0;
+        size_t filled = carried + static_cast<size_t>(got);
+
+        // everything up to the last delimiter is complete
+        size_t complete = filled;
+        if (!at_end) {
+            while (complete > 0 && !ics_detail::is_text_delimiter(buffer[complete - 1])) {
+                --complete;
+            }
+            if (complete == 0 && filled == buffer.size()) {
+                throw VectorException("token longer than the parse chunk");
+            }
+        }
+
+        std::string_view text(buffer.data(), complete);
+        ics_detail::reserve_text_tokens(out, ics_detail::count_text_tokens(text));
+        parsed += ics_detail::parse_tokens(out, text.data(), text.data() + text.size());
+
+        carried = filled - complete;
+        std::memmove(buffer.data(), buffer.data() + complete, carried);
+    }
+    return parsed;
+}
+
+#endif
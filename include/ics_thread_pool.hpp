@@ -0,0 +1,523 @@
+#ifndef ICS_THREAD_POOL_HPP
+#define ICS_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "ics_cache_line.hpp"
+#include "ics_thread_registry.hpp"
+#include "ics_vector.hpp"
+
+// Work-stealing thread pool, the executor under the parallel algorithms.
+//
+// Every worker owns a Chase-Lev deque: it pushes and pops tasks at the
+// bottom without contention, while idle workers steal from the top of a
+// random victim's deque. Tasks spawned by a worker go to its own deque, so
+// fork-join code runs depth first on one worker and spreads out only when
+// others run dry. Threads outside the pool hand tasks over through a
+// shared injection queue.
+//
+// TaskGroup::wait() runs queued tasks, its own or any other, until its
+// group is done instead of blocking, so nested parallelism cannot deadlock
+// the pool even with every worker waiting. Idle workers and waiters spin
+// briefly, then sleep on one pool-wide signal that new tasks and finished
+// groups raise.
+
+class ThreadPool;
+class TaskGroup;
+
+namespace ics_detail {
+    struct PoolTask {
+        virtual ~PoolTask() = default;
+        virtual void run() noexcept = 0;
+    };
+
+    // Chase-Lev work-stealing deque (the C11 formulation of Le et al.).
+    // push and pop belong to the owner; steal may run on any thread. The
+    // array grows by doubling; outgrown arrays stay allocated until the
+    // deque is destroyed, as a thief may still be reading one.
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    class ChaseLevDeque {
+    private:
+        struct Array {
+            int64_t mask;
+            std::unique_ptr<std::atomic<T>[]> slots;
+
+            explicit Array(int64_t capacity) : mask(capacity - 1), slots(new std::atomic<T>[capacity]) {}
+
+            T get(int64_t index) const noexcept {
+                return slots[index & mask].load(std::memory_order_relaxed);
+            }
+
+            void put(int64_t index, T value) noexcept {
+                slots[index & mask].store(value, std::memory_order_relaxed);
+            }
+        };
+
+        alignas(cache_line_size) std::atomic<int64_t> m_top;
+        alignas(cache_line_size) std::atomic<int64_t> m_bottom;
+        std::atomic<Array*> m_array;
+        Vector<std::unique_ptr<Array>> m_arrays;  // owner only
+
+        Array* grow(Array* old, int64_t top, int64_t bottom) {
+            auto bigger = std::make_unique<Array>((old->mask + 1) * 2);
+            for (int64_t i = top; i < bottom; ++i) {
+                bigger->put(i, old->get(i));
+            }
+            Array* raw = bigger.get();
+            m_arrays.push_back(std::move(bigger));
+            m_array.store(raw, std::memory_order_release);
+            return raw;
+        }
+
+    public:
+        explicit ChaseLevDeque(int64_t capacity = 256) : m_top(0), m_bottom(0) {
+            m_arrays.push_back(std::make_unique<Array>(capacity));
+            m_array.store(m_arrays[0].get(), std::memory_order_relaxed);
+        }
+
+        ChaseLevDeque(const ChaseLevDeque&) = delete;
+        ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+        void push(T value) {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            int64_t top = m_top.load(std::memory_order_acquire);
+            Array* array = m_array.load(std::memory_order_relaxed);
+            if (bottom - top > array->mask) {
+                array = grow(array, top, bottom);
+            }
+            array->put(bottom, value);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        // Takes the most recently pushed value.
+        bool pop(T& out) noexcept {
+            int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            Array* array = m_array.load(std::memory_order_relaxed);
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_top.load(std::memory_order_relaxed);
+            if (top > bottom) {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return false;
+            }
+            out = array->get(bottom);
+            if (top == bottom) {
+                // last element: race the thieves for it
+                bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                         std::memory_order_relaxed);
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return won;
+            }
+            return true;
+        }
+
+        // Takes the oldest value; false if empty or another thread won it.
+        bool steal(T& out) noexcept {
+            int64_t top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = m_bottom.load(std::memory_order_acquire);
+            if (top >= bottom) {
+                return false;
+            }
+            Array* array = m_array.load(std::memory_order_acquire);
+            out = array->get(top);
+            return m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        }
+
+        bool empty() const noexcept {
+            return m_bottom.load(std::memory_order_acquire) <= m_top.load(std::memory_order_acquire);
+        }
+    };
+
+    // The pool and worker index of the calling thread, if it is a worker.
+    struct WorkerContext {
+        const ThreadPool* pool = nullptr;
+        size_t index = 0;
+    };
+
+    inline WorkerContext& current_worker() noexcept {
+        static thread_local WorkerContext context;
+        return context;
+    }
+}
+
+// Counters summed over the workers. They are updated with relaxed atomics,
+// so a snapshot taken while the pool runs is only approximately consistent.
+struct ThreadPoolStats {
+    uint64_t executed = 0;       // tasks run, including by waiting outside threads
+    uint64_t stolen = 0;         // tasks taken from another worker's deque
+    uint64_t failed_steals = 0;  // steal attempts that found nothing or lost a race
+    uint64_t sleeps = 0;         // times a worker went to sleep for lack of work
+};
+
+class ThreadPool {
+private:
+    using Task = ics_detail::PoolTask;
+
+    struct Worker {
+        ics_detail::ChaseLevDeque<Task*> deque;
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> stolen{0};
+        std::atomic<uint64_t> failed_steals{0};
+        std::atomic<uint64_t> sleeps{0};
+        uint64_t rng;
+
+        explicit Worker(uint64_t seed) : rng(seed) {}
+    };
+
+    static constexpr int spin_rounds = 64;
+
+    Vector<std::unique_ptr<ics_detail::CacheAligned<Worker>>> m_workers;
+    Vector<std::thread> m_threads;
+
+    std::mutex m_inject_mutex;
+    Vector<Task*> m_injected;  // guarded by m_inject_mutex, taken from m_inject_head
+    size_t m_inject_head = 0;
+    std::atomic<size_t> m_inject_count{0};
+    std::atomic<uint64_t> m_outside_executed{0};
+
+    alignas(ics_detail::cache_line_size) std::atomic<uint32_t> m_signal{0};
+    std::atomic<uint32_t> m_sleepers{0};
+    std::atomic<bool> m_stop{false};
+
+    friend class TaskGroup;
+
+    Worker& worker(size_t index) noexcept {
+        return m_workers[index]->value;
+    }
+
+    size_t own_index() const noexcept {
+        const ics_detail::WorkerContext& context = ics_detail::current_worker();
+        return context.pool == this ? context.index : SIZE_MAX;
+    }
+
+    void schedule(Task* task) {
+        size_t index = own_index();
+        if (index != SIZE_MAX) {
+            worker(index).deque.push(task);
+        } else {
+            std::lock_guard<std::mutex> lock(m_inject_mutex);
+            m_injected.push_back(task);
+            m_inject_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        wake(false);
+    }
+
+    // Raises the signal if anyone sleeps on it. The fence pairs with the
+    // sleeper's increment of m_sleepers before its last look for work.
+    void wake(bool everyone) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_sleepers.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+        m_signal.fetch_add(1, std::memory_order_release);
+        if (everyone) {
+            m_signal.notify_all();
+        } else {
+            m_signal.notify_one();
+        }
+    }
+
+    Task* take_injected() {
+        if (m_inject_count.load(std::memory_order_relaxed) == 0) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(m_inject_mutex);
+        if (m_inject_head == m_injected.size()) {
+            return nullptr;
+        }
+        Task* task = m_injected[m_inject_head++];
+        m_inject_count.fetch_sub(1, std::memory_order_relaxed);
+        if (m_inject_head == m_injected.size()) {
+            m_injected.clear();
+            m_inject_head = 0;
+        }
+        return task;
+    }
+
+    // Own deque first, then the injection queue, then one steal attempt
+    // from each other worker, starting at a random one.
+    Task* find_task(size_t self) {
+        Task* task = nullptr;
+        if (self != SIZE_MAX && worker(self).deque.pop(task)) {
+            return task;
+        }
+        if ((task = take_injected()) != nullptr) {
+            return task;
+        }
+        size_t count = m_workers.size();
+        uint64_t random = 0;
+        if (self != SIZE_MAX) {
+            // xorshift
+            uint64_t& state = worker(self).rng;
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            random = state;
+        } else {
+            random = std::hash<std::thread::id>()(std::this_thread::get_id());
+        }
+        for (size_t k = 0; k < count; ++k) {
+            size_t victim = (random + k) % count;
+            if (victim == self) {
+                continue;
+            }
+            bool got = worker(victim).deque.steal(task);
+            if (self != SIZE_MAX) {
+                (got ? worker(self).stolen : worker(self).failed_steals).fetch_add(1, std::memory_order_relaxed);
+            }
+            if (got) {
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    bool has_work() const noexcept {
+        if (m_inject_count.load(std::memory_order_relaxed) != 0) {
+            return true;
+        }
+        for (const std::unique_ptr<ics_detail::CacheAligned<Worker>>& entry : m_workers) {
+            if (!entry->value.deque.empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void execute(Task* task, size_t self) {
+        // counted first, so a waiter released by this task already sees it
+        (self != SIZE_MAX ? worker(self).executed : m_outside_executed).fetch_add(1, std::memory_order_relaxed);
+        task->run();
+        delete task;
+    }
+
+    // Runs tasks until done() holds, sleeping when there is nothing to run.
+    template <typename Done>
+    void work_until(Done&& done) {
+        size_t self = own_index();
+        int idle = 0;
+        while (!done()) {
+            if (Task* task = find_task(self)) {
+                execute(task, self);
+                idle = 0;
+                continue;
+            }
+            if (++idle < spin_rounds) {
+                ics_detail::spin_pause();
+                continue;
+            }
+            uint32_t signal = m_signal.load(std::memory_order_acquire);
+            m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if (!has_work() && !done()) {
+                if (self != SIZE_MAX) {
+                    worker(self).sleeps.fetch_add(1, std::memory_order_relaxed);
+                }
+                m_signal.wait(signal, std::memory_order_acquire);
+            }
+            m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+            idle = 0;
+        }
+    }
+
+    void worker_main(size_t index) {
+        ics_detail::current_worker() = ics_detail::WorkerContext{this, index};
+        // keeps running queued tasks after stop until none are left
+        work_until([&] {
+            return m_stop.load(std::memory_order_acquire) && !has_work();
+        });
+    }
+
+public:
+    // threads = 0 uses every hardware thread.
+    explicit ThreadPool(size_t threads = 0) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (size_t i = 0; i < threads; ++i) {
+            m_workers.push_back(std::make_unique<ics_detail::CacheAligned<Worker>>(0x9e3779b97f4a7c15ull * (i + 1)));
+        }
+        for (size_t i = 0; i < threads; ++i) {
+            m_threads.push_back(std::thread([this, i] { worker_main(i); }));
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Finishes the queued tasks, then joins the workers.
+    ~ThreadPool() {
+        m_stop.store(true, std::memory_order_release);
+        m_signal.fetch_add(1, std::memory_order_release);
+        m_signal.notify_all();
+        for (std::thread& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    // Shared pool with one worker per hardware thread, created on first use.
+    static ThreadPool& global() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    size_t size() const noexcept {
+        return m_workers.size();
+    }
+
+    // Index of the calling worker thread, or SIZE_MAX outside this pool.
+    size_t current_worker() const noexcept {
+        return own_index();
+    }
+
+    ThreadPoolStats stats() const noexcept {
+        ThreadPoolStats total;
+        total.executed = m_outside_executed.load(std::memory_order_relaxed);
+        for (const std::unique_ptr<ics_detail::CacheAligned<Worker>>& entry : m_workers) {
+            const Worker& w = entry->value;
+            total.executed += w.executed.load(std::memory_order_relaxed);
+            total.stolen += w.stolen.load(std::memory_order_relaxed);
+            total.failed_steals += w.failed_steals.load(std::memory_order_relaxed);
+            total.sleeps += w.sleeps.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+};
+
+// Tasks that finish together. run() may be called from any thread,
+// including from inside the group's own tasks; wait() helps run queued
+// tasks and rethrows the first exception a task of the group threw.
+class TaskGroup {
+private:
+    template <typename F>
+    struct Task final : ics_detail::PoolTask {
+        TaskGroup* group;
+        F work;
+
+        Task(TaskGroup* owner, F&& f) : group(owner), work(std::move(f)) {}
+
+        void run() noexcept override {
+            try {
+                work();
+            } catch (...) {
+                group->fail(std::current_exception());
+            }
+            // the group may be gone as soon as pending reaches zero
+            ThreadPool& pool = *group->m_pool;
+            if (group->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                pool.wake(true);
+            }
+        }
+    };
+
+    ThreadPool* m_pool;
+    std::atomic<size_t> m_pending{0};
+    std::mutex m_error_mutex;
+    std::exception_ptr m_error;
+
+    void fail(std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(m_error_mutex);
+        if (!m_error) {
+            m_error = std::move(error);
+        }
+    }
+
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::global()) noexcept : m_pool(&pool) {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup() {
+        m_pool->work_until([&] {
+            return m_pending.load(std::memory_order_acquire) == 0;
+        });
+    }
+
+    ThreadPool& pool() const noexcept {
+        return *m_pool;
+    }
+
+    template <typename F>
+    void run(F&& f) {
+        auto* task = new Task<std::decay_t<F>>(this, std::decay_t<F>(std::forward<F>(f)));
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+        m_pool->schedule(task);
+    }
+
+    void wait() {
+        m_pool->work_until([&] {
+            return m_pending.load(std::memory_order_acquire) == 0;
+        });
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(m_error_mutex);
+            error = std::exchange(m_error, nullptr);
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+// Runs every function, the first on the calling thread and the others as
+// tasks of pool, and returns once all are done.
+template <typename F, typename... Fs>
+    requires std::is_invocable_v<F&> && (std::is_invocable_v<Fs&> && ...)
+void parallel_invoke(ThreadPool& pool, F&& first, Fs&&... rest) {
+    TaskGroup group(pool);
+    (group.run(std::forward<Fs>(rest)), ...);
+    // if first throws, ~TaskGroup still waits for the others
+    first();
+    group.wait();
+}
+
+template <typename F, typename... Fs>
+    requires std::is_invocable_v<F&> && (std::is_invocable_v<Fs&> && ...)
+void parallel_invoke(F&& first, Fs&&... rest) {
+    parallel_invoke(ThreadPool::global(), std::forward<F>(first), std::forward<Fs>(rest)...);
+}
+
+// One T per worker of a pool, on its own cache lines, plus one per outside
+// thread that asks. local() is what a task uses to accumulate without
+// sharing; for_each visits every value once the tasks are done.
+template <typename T>
+class WorkerLocal {
+private:
+    ThreadPool* m_pool;
+    Vector<std::unique_ptr<ics_detail::CacheAligned<T>>> m_workers;
+    ics_detail::ThreadRegistry<T> m_outside;
+
+public:
+    explicit WorkerLocal(ThreadPool& pool = ThreadPool::global()) : m_pool(&pool) {
+        for (size_t i = 0; i < pool.size(); ++i) {
+            m_workers.push_back(std::make_unique<ics_detail::CacheAligned<T>>());
+        }
+    }
+
+    T& local() {
+        size_t index = m_pool->current_worker();
+        return index != SIZE_MAX ? m_workers[index]->value : m_outside.local();
+    }
+
+    template <typename F>
+    void for_each(F&& f) {
+        for (const std::unique_ptr<ics_detail::CacheAligned<T>>& entry : m_workers) {
+            f(entry->value);
+        }
+        m_outside.for_each(f);
+    }
+};
+
+#endif
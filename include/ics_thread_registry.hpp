@@ -0,0 +1,118 @@
+#ifndef ICS_THREAD_REGISTRY_HPP
+#define ICS_THREAD_REGISTRY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "ics_cache_line.hpp"
+#include "ics_vector.hpp"
+
+namespace ics_detail {
+    inline uint64_t next_registry_id() noexcept {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    // One S per thread that asks for it, created on first use and kept, at a
+    // fixed address, until the registry is cleared or destroyed. Each thread
+    // caches its values for up to eight recently used registries, checked
+    // in turn so registries whose ids collide do not evict each other. A
+    // miss walks a lock-free list of the registry's entries; only a
+    // thread's first local() call takes the lock, to add its entry.
+    template <typename S>
+    class ThreadRegistry {
+    private:
+        struct Entry {
+            std::thread::id thread;
+            S value;
+            Entry* next = nullptr;
+        };
+
+        struct Cache {
+            uint64_t registry = 0;
+            S* value = nullptr;
+        };
+
+        static constexpr size_t cache_ways = 8;
+
+        struct RecentCache {
+            Cache ways[cache_ways];
+            size_t victim = 0;
+        };
+
+        static RecentCache& recent() noexcept {
+            static thread_local RecentCache cache;
+            return cache;
+        }
+
+        uint64_t m_id;
+        // newest first; entries are only added, by their own thread
+        std::atomic<Entry*> m_head;
+        mutable std::mutex m_mutex;
+        Vector<std::unique_ptr<CacheAligned<Entry>>> m_entries;
+
+        S* find(std::thread::id self) const noexcept {
+            for (Entry* entry = m_head.load(std::memory_order_acquire); entry != nullptr; entry = entry->next) {
+                if (entry->thread == self) {
+                    return &entry->value;
+                }
+            }
+            return nullptr;
+        }
+
+    public:
+        ThreadRegistry() : m_id(next_registry_id()), m_head(nullptr) {}
+
+        ThreadRegistry(const ThreadRegistry&) = delete;
+        ThreadRegistry& operator=(const ThreadRegistry&) = delete;
+
+        S& local() {
+            RecentCache& cache = recent();
+            for (Cache& way : cache.ways) {
+                if (way.registry == m_id) {
+                    return *way.value;
+                }
+            }
+            std::thread::id self = std::this_thread::get_id();
+            S* found = find(self);
+            if (found == nullptr) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_entries.push_back(std::make_unique<CacheAligned<Entry>>(self));
+                Entry* entry = &m_entries[m_entries.size() - 1]->value;
+                entry->next = m_head.load(std::memory_order_relaxed);
+                m_head.store(entry, std::memory_order_release);
+                found = &entry->value;
+            }
+            cache.ways[cache.victim++ % cache_ways] = Cache{m_id, found};
+            return *found;
+        }
+
+        size_t size() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.size();
+        }
+
+        // Calls f(S&) for every thread's value in creation order. Threads
+        // must not be writing to their values meanwhile.
+        template <typename F>
+        void for_each(F&& f) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const std::unique_ptr<CacheAligned<Entry>>& entry : m_entries) {
+                f(entry->value.value);
+            }
+        }
+
+        // Drops every value; a fresh id invalidates the threads' caches.
+        void clear() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_head.store(nullptr, std::memory_order_relaxed);
+            m_entries.clear();
+            m_id = next_registry_id();
+        }
+    };
+}
+
+#endif
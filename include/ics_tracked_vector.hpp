@@ -0,0 +1,370 @@
+#ifndef ICS_TRACKED_VECTOR_HPP
+#define ICS_TRACKED_VECTOR_HPP
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "ics_crc32c.hpp"
+#include "ics_file.hpp"
+#include "ics_vector.hpp"
+#include "ics_vector_io.hpp"
+#include "vector_exception.hpp"
+
+// Incremental checkpoints. TrackedVector wraps a Vector and marks the block
+// of every element handed out for writing in a dirty bitmap; a checkpoint
+// holds the new size plus only the dirty blocks, each with a CRC32C, and
+// apply_checkpoint patches a reader's copy with it.
+//
+// A checkpoint is a CheckpointHeader followed by `blocks` records, each a
+// CheckpointBlock and its `length` elements.
+
+struct CheckpointHeader {
+    static constexpr char magic_bytes[4] = {'I', 'C', 'S', 'D'};
+    static constexpr uint16_t current_version = 1;
+
+    char magic[4];
+    uint16_t version;
+    uint8_t type_tag;
+    uint8_t flags;
+    uint32_t element_size;
+    uint32_t block_size;  // elements per block
+    uint64_t count;       // vector size after the checkpoint
+    uint64_t blocks;
+};
+
+struct CheckpointBlock {
+    uint64_t index;
+    uint32_t length;    // elements, short for the last block
+    uint32_t checksum;  // CRC32C of the element bytes
+};
+
+static_assert(sizeof(CheckpointHeader) == 32 && sizeof(CheckpointBlock) == 16);
+
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+class TrackedVector {
+private:
+    Vector<T> m_values;
+    Vector<uint64_t> m_dirty;
+    unsigned m_block_shift;
+
+    void ensure_bitmap(size_t blocks) {
+        while (m_dirty.size() * 64 < blocks) {
+            m_dirty.push_back(0);
+        }
+    }
+
+    void mark_block(size_t block) noexcept {
+        m_dirty[block / 64] |= uint64_t{1} << (block % 64);
+    }
+
+    void mark(size_t index) {
+        size_t block = index >> m_block_shift;
+        ensure_bitmap(block + 1);
+        mark_block(block);
+    }
+
+    size_t block_count() const noexcept {
+        return (m_values.size() + block_size() - 1) >> m_block_shift;
+    }
+
+    class Iterator {
+    private:
+        TrackedVector* m_container;
+        size_t m_index;
+
+        friend class TrackedVector;
+
+    public:
+        Iterator(TrackedVector* container, size_t index) noexcept : m_container(container), m_index(index) {}
+
+        T& operator*() const {
+            return m_container->at(m_index);
+        }
+
+        T* operator->() const {
+            return &m_container->at(m_index);
+        }
+
+        Iterator& operator++() noexcept {
+            ++m_index;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator temp = *this;
+            ++m_index;
+            return temp;
+        }
+
+        Iterator operator+(size_t offset) const noexcept {
+            return Iterator(m_container, m_index + offset);
+        }
+
+        size_t operator-(const Iterator& other) const noexcept {
+            return m_index - other.m_index;
+        }
+
+        bool operator==(const Iterator& other) const noexcept {
+            return m_container == other.m_container && m_index == other.m_index;
+        }
+    };
+
+public:
+    // block_size is rounded up to a power of two. Every existing element
+    // starts dirty, so the first checkpoint carries the whole vector.
+    explicit TrackedVector(Vector<T> values = Vector<T>(), size_t block_size = 512)
+        : m_values(std::move(values)), m_block_shift(static_cast<unsigned>(std::bit_width(block_size - 1))) {
+        // the rounded size has to fit CheckpointHeader::block_size
+        if (block_size == 0 || m_block_shift >= 32) {
+            throw VectorException("invalid checkpoint block size");
+        }
+        mark_all_dirty();
+    }
+
+    size_t size() const noexcept {
+        return m_values.size();
+    }
+
+    bool empty() const noexcept {
+        return m_values.empty();
+    }
+
+    size_t block_size() const noexcept {
+        return size_t{1} << m_block_shift;
+    }
+
+    const Vector<T>& values() const noexcept {
+        return m_values;
+    }
+
+    T& operator[](size_t index) {
+        mark(index);
+        return m_values[index];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return m_values[index];
+    }
+
+    T& at(size_t index) {
+        if (index >= m_values.size()) {
+            throw VectorException("out of bounds");
+        }
+        return (*this)[index];
+    }
+
+    const T& at(size_t index) const {
+        return m_values.at(index);
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, m_values.size());
+    }
+
+    const T* begin() const noexcept {
+        return m_values.begin();
+    }
+
+    const T* end() const noexcept {
+        return m_values.end();
+    }
+
+    void push_back(const T& value) {
+        mark(m_values.size());
+        m_values.push_back(value);
+    }
+
+    void pop_back() {
+        m_values.pop_back();
+    }
+
+    // Removes [start, end); every block from start onwards shifts.
+    void erase(Iterator start, Iterator end) {
+        if (start.m_index >= end.m_index) {
+            return;
+        }
+        if (end.m_index > m_values.size()) {
+            throw VectorException("out of bounds");
+        }
+        for (size_t block = start.m_index >> m_block_shift; block < block_count(); ++block) {
+            mark_block(block);
+        }
+        size_t count = end.m_index - start.m_index;
+        T* data = &m_values[0];
+        std::memmove(data + start.m_index, data + end.m_index, (m_values.size() - end.m_index) * sizeof(T));
+        for (size_t i = 0; i < count; ++i) {
+            m_values.pop_back();
+        }
+    }
+
+    bool is_dirty(size_t block) const noexcept {
+        return block / 64 < m_dirty.size() && (m_dirty[block / 64] >> (block % 64) & 1);
+    }
+
+    // Dirty blocks that still hold elements.
+    size_t dirty_count() const noexcept {
+        size_t blocks = block_count();
+        size_t count = 0;
+        for (size_t word = 0; word < m_dirty.size() && word * 64 < blocks; ++word) {
+            uint64_t bits = m_dirty[word];
+            if (blocks - word * 64 < 64) {
+                bits &= (uint64_t{1} << (blocks - word * 64)) - 1;
+            }
+            count += static_cast<size_t>(std::popcount(bits));
+        }
+        return count;
+    }
+
+    void mark_all_dirty() {
+        ensure_bitmap(block_count());
+        for (size_t block = 0; block < block_count(); ++block) {
+            mark_block(block);
+        }
+    }
+
+    void clear_dirty() noexcept {
+        for (uint64_t& word : m_dirty) {
+            word = 0;
+        }
+    }
+
+    // Writes the current size and every dirty block to fd, then clears the
+    // dirty bitmap. The element bytes go out straight from the buffer in
+    // writev batches. Returns the number of blocks written.
+    size_t write_checkpoint(int fd) {
+        size_t blocks = block_count();
+        Vector<CheckpointBlock> records(dirty_count());
+        for (size_t block = 0; block < blocks; ++block) {
+            if (is_dirty(block)) {
+                size_t first = block << m_block_shift;
+                size_t length = std::min(block_size(), m_values.size() - first);
+                records.push_back(CheckpointBlock{
+                    block, static_cast<uint32_t>(length), crc32c(m_values.data() + first, length * sizeof(T))});
+            }
+        }
+
+        BinaryHeader format = ics_detail::make_binary_header<T>(m_values.size());
+        CheckpointHeader header{};
+        std::memcpy(header.magic, CheckpointHeader::magic_bytes, sizeof(header.magic));
+        header.version = CheckpointHeader::current_version;
+        header.type_tag = format.type_tag;
+        header.flags = format.flags;
+        header.element_size = sizeof(T);
+        header.block_size = static_cast<uint32_t>(block_size());
+        header.count = m_values.size();
+        header.blocks = records.size();
+
+        Vector<struct iovec> iov(2 * records.size() + 1);
+        iov.push_back({&header, sizeof(header)});
+        for (CheckpointBlock& record : records) {
+            iov.push_back({&record, sizeof(record)});
+            iov.push_back({const_cast<T*>(m_values.data()) + (record.index << m_block_shift),
+                           record.length * sizeof(T)});
+        }
+        for (size_t first = 0; first < iov.size(); first += IOV_MAX) {
+            size_t count = std::min<size_t>(IOV_MAX, iov.size() - first);
+            ics_detail::write_all_v(fd, &iov[first], static_cast<int>(count));
+        }
+        clear_dirty();
+        return records.size();
+    }
+};
+
+// Reads one checkpoint from fd and applies it to target: resizes target to
+// the checkpointed size and overwrites the blocks it carries. The whole
+// checkpoint is read and verified before target is touched. Checkpoints must
+// be applied in the order they were written. Returns the number of blocks
+// applied.
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+size_t apply_checkpoint(Vector<T>& target, int fd) {
+    CheckpointHeader header;
+    ics_detail::read_exact(fd, &header, sizeof(header));
+    if (std::memcmp(header.magic, CheckpointHeader::magic_bytes, sizeof(header.magic)) != 0) {
+        throw VectorException("not a checkpoint");
+    }
+    if (header.version == 0 || header.version > CheckpointHeader::current_version) {
+        throw VectorException("unsupported checkpoint version " + std::to_string(header.version));
+    }
+    BinaryHeader expected = ics_detail::make_binary_header<T>(0);
+    if (header.flags != expected.flags || header.type_tag != expected.type_tag
+        || header.element_size != sizeof(T)) {
+        throw VectorException("checkpoint element type mismatch");
+    }
+    if (header.block_size == 0 || header.count > SIZE_MAX / sizeof(T)
+        || header.blocks > (header.count + header.block_size - 1) / header.block_size) {
+        throw VectorException("corrupt checkpoint header");
+    }
+    size_t count = static_cast<size_t>(header.count);
+    // every record holds at least one element
+    size_t remaining = ics_detail::remaining_bytes(fd);
+    if (remaining != SIZE_MAX && header.blocks > remaining / (sizeof(CheckpointBlock) + sizeof(T))) {
+        throw VectorException("unexpected end of file: checkpoint blocks exceed the file");
+    }
+
+    Vector<CheckpointBlock> records(std::min(static_cast<size_t>(header.blocks), ics_detail::max_initial_reserve));
+    Vector<T> payload;
+    for (size_t i = 0; i < header.blocks; ++i) {
+        CheckpointBlock record;
+        ics_detail::read_exact(fd, &record, sizeof(record));
+        if (record.index > count / header.block_size
+            || record.length != std::min<size_t>(header.block_size, count - record.index * header.block_size)
+            || record.length == 0) {
+            throw VectorException("corrupt checkpoint block");
+        }
+        T* slot = payload.append_uninitialized(record.length);
+        ics_detail::read_exact(fd, slot, record.length * sizeof(T));
+        if (crc32c(slot, record.length * sizeof(T)) != record.checksum) {
+            throw VectorException("checkpoint block " + std::to_string(record.index) + " checksum mismatch");
+        }
+        records.push_back(record);
+    }
+    // each block at most once, and every block past the end of target
+    // present, since only the blocks just read can fill the new elements
+    Vector<uint64_t> indices(records.size());
+    for (const CheckpointBlock& record : records) {
+        indices.push_back(record.index);
+    }
+    std::sort(&indices[0], &indices[0] + indices.size());
+    for (size_t i = 1; i < indices.size(); ++i) {
+        if (indices[i] == indices[i - 1]) {
+            throw VectorException("checkpoint block " + std::to_string(indices[i]) + " repeated");
+        }
+    }
+    if (count > target.size()) {
+        uint64_t first_new = target.size() / header.block_size;
+        uint64_t last = (count - 1) / header.block_size;
+        const uint64_t* begin = indices.data();
+        const uint64_t* end = begin + indices.size();
+        const uint64_t* tail = std::lower_bound(begin, end, first_new);
+        if (static_cast<uint64_t>(end - tail) != last - first_new + 1) {
+            throw VectorException("checkpoint grows the vector past its blocks");
+        }
+    }
+
+    while (target.size() > count) {
+        target.pop_back();
+    }
+    if (target.size() < count) {
+        target.append_uninitialized(count - target.size());
+    }
+    const T* source = payload.data();
+    for (const CheckpointBlock& record : records) {
+        std::memcpy(&target[record.index * header.block_size], source, record.length * sizeof(T));
+        source += record.length;
+    }
+    return records.size();
+}
+
+#endif
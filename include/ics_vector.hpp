@@ -3,7 +3,10 @@
 
 #include <iosfwd>
 #include <cstddef>
+#include <new>
+#include <type_traits>
 #include <utility>
+#include "ics_text_format.hpp"
 #include "vector_exception.hpp"
 
 template <typename T>
@@ -121,13 +124,25 @@ private:
     size_t m_size;
     T* m_buffer;
 
+    // Over-aligned T (e.g. cache-line-aligned slots) needs the aligned
+    // overloads; plain operator new only guarantees the default alignment.
+    static constexpr bool over_aligned = alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
     T* allocate(size_t n) {
         if (n == 0) return nullptr;
-        return static_cast<T*>(::operator new(n * sizeof(T)));
+        if constexpr (over_aligned) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+        } else {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
     }
 
     void deallocate(T* ptr) {
-        ::operator delete(ptr);
+        if constexpr (over_aligned) {
+            ::operator delete(ptr, std::align_val_t{alignof(T)});
+        } else {
+            ::operator delete(ptr);
+        }
     }
 
 public:
@@ -272,6 +287,19 @@ public:
         ++m_size;
     }
 
+    // Grows the size by n without constructing the new elements and returns a
+    // pointer to the first of them, so bulk readers can fill the buffer in
+    // place. The caller must write all n elements before reading them.
+    T* append_uninitialized(size_t n) requires std::is_trivially_copyable_v<T> {
+        if (m_size + n > m_capacity) {
+            size_t new_capacity = m_capacity * 2 > m_size + n ? m_capacity * 2 : m_size + n;
+            resize(new_capacity);
+        }
+        T* first = m_buffer + m_size;
+        m_size += n;
+        return first;
+    }
+
     void pop_back() {
         if (m_size == 0) {
             throw VectorException("popping from empty");
@@ -380,6 +408,14 @@ public:
     }
 
     friend std::ostream& operator<<(std::ostream& os, const Vector& vec) {
+        if constexpr (TextFormattable<T>) {
+            if (ics_detail::stream_is_plain(os)) {
+                TextFormat format;
+                format.precision = static_cast<int>(os.precision());
+                write_text(os, vec.m_buffer, vec.m_size, format);
+                return os;
+            }
+        }
         for (size_t i = 0; i < vec.m_size; ++i) {
             os << vec.m_buffer[i] << " ";
         }
@@ -0,0 +1,402 @@
+#ifndef ICS_VECTOR_IO_HPP
+#define ICS_VECTOR_IO_HPP
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include "ics_file.hpp"
+#include "ics_vector.hpp"
+#include "vector_exception.hpp"
+
+// Versioned binary format for Vector. A file is a 32-byte BinaryHeader
+// followed by the payload: the raw element bytes for trivially copyable T, or
+// the VectorSerializer<T> encoding of each element otherwise.
+
+enum class VectorTypeTag : uint8_t {
+    custom = 0,
+    raw = 1,
+    boolean = 2,
+    int8 = 3,
+    uint8 = 4,
+    int16 = 5,
+    uint16 = 6,
+    int32 = 7,
+    uint32 = 8,
+    int64 = 9,
+    uint64 = 10,
+    float32 = 11,
+    float64 = 12,
+};
+
+struct BinaryHeader {
+    static constexpr char magic_bytes[4] = {'I', 'C', 'S', 'V'};
+    static constexpr uint16_t current_version = 1;
+    static constexpr uint8_t flag_big_endian = 1;
+    static constexpr uint8_t flag_compressed = 2;
+
+    char magic[4];
+    uint16_t version;
+    uint8_t type_tag;
+    uint8_t flags;
+    uint32_t element_size;
+    uint32_t reserved;
+    uint64_t count;
+    uint64_t extra;
+};
+
+static_assert(sizeof(BinaryHeader) == 32 && std::is_trivially_copyable_v<BinaryHeader>);
+
+template <typename T>
+constexpr VectorTypeTag vector_type_tag() noexcept {
+    if constexpr (std::is_same_v<T, bool>) {
+        return VectorTypeTag::boolean;
+    } else if constexpr (std::is_integral_v<T>) {
+        constexpr int width = static_cast<int>(std::bit_width(sizeof(T))) - 1;
+        return static_cast<VectorTypeTag>(static_cast<int>(VectorTypeTag::int8) + 2 * width
+                                          + (std::is_signed_v<T> ? 0 : 1));
+    } else if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4) {
+        return VectorTypeTag::float32;
+    } else if constexpr (std::is_floating_point_v<T> && sizeof(T) == 8) {
+        return VectorTypeTag::float64;
+    } else if constexpr (std::is_trivially_copyable_v<T>) {
+        return VectorTypeTag::raw;
+    } else {
+        return VectorTypeTag::custom;
+    }
+}
+
+// Buffered sequential writer handed to VectorSerializer<T>::write.
+class BinaryWriter {
+private:
+    static constexpr size_t buffer_size = size_t{1} << 20;
+
+    int m_fd;
+    Vector<char> m_buffer;
+
+public:
+    explicit BinaryWriter(int fd) : m_fd(fd), m_buffer(buffer_size) {}
+
+    BinaryWriter(const BinaryWriter&) = delete;
+    BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+    void write_bytes(const void* data, size_t n) {
+        if (m_buffer.size() + n > buffer_size) {
+            flush();
+        }
+        if (n >= buffer_size) {
+            ics_detail::write_all(m_fd, data, n);
+            return;
+        }
+        std::memcpy(m_buffer.append_uninitialized(n), data, n);
+    }
+
+    template <typename U>
+    void write_value(const U& value) requires std::is_trivially_copyable_v<U> {
+        write_bytes(&value, sizeof(U));
+    }
+
+    void flush() {
+        ics_detail::write_all(m_fd, m_buffer.data(), m_buffer.size());
+        m_buffer.clear();
+    }
+};
+
+namespace ics_detail {
+    // Most elements reserved ahead of reading elements whose encoded size is
+    // unknown; a corrupt count then costs growth, not a huge allocation.
+    inline constexpr size_t max_initial_reserve = size_t{1} << 16;
+}
+
+// Buffered sequential reader handed to VectorSerializer<T>::read. Reading
+// ahead may pull bytes past the Vector; finish() seeks back over them when fd
+// is seekable so the stream can hold more data after it.
+//
+// Length prefixes come from the file and are checked with read_count against
+// the bytes left in it before anything is allocated for them.
+class BinaryReader {
+private:
+    static constexpr size_t buffer_size = size_t{1} << 20;
+
+    int m_fd;
+    Vector<char> m_buffer;
+    size_t m_pos;
+    size_t m_end;
+    size_t m_unread;    // file bytes not yet buffered; SIZE_MAX if unknown
+
+    void consumed(size_t n) noexcept {
+        if (m_unread != SIZE_MAX) {
+            m_unread -= n < m_unread ? n : m_unread;
+        }
+    }
+
+    void refill() {
+        ssize_t got;
+        do {
+            got = ::read(m_fd, m_buffer.data(), buffer_size);
+        } while (got < 0 && errno == EINTR);
+        if (got <= 0) {
+            throw VectorException(got == 0 ? "unexpected end of file" : "read failed");
+        }
+        m_pos = 0;
+        m_end = static_cast<size_t>(got);
+        consumed(m_end);
+    }
+
+public:
+    explicit BinaryReader(int fd) : m_fd(fd), m_pos(0), m_end(0), m_unread(ics_detail::remaining_bytes(fd)) {
+        m_buffer.append_uninitialized(buffer_size);
+    }
+
+    BinaryReader(const BinaryReader&) = delete;
+    BinaryReader& operator=(const BinaryReader&) = delete;
+
+    void read_bytes(void* data, size_t n) {
+        char* out = static_cast<char*>(data);
+        while (n > 0) {
+            if (m_pos == m_end) {
+                if (n >= buffer_size) {
+                    ics_detail::read_exact(m_fd, out, n);
+                    consumed(n);
+                    return;
+                }
+                refill();
+            }
+            size_t available = m_end - m_pos;
+            size_t take = n < available ? n : available;
+            std::memcpy(out, m_buffer.data() + m_pos, take);
+            m_pos += take;
+            out += take;
+            n -= take;
+        }
+    }
+
+    template <typename U>
+    U read_value() requires std::is_trivially_copyable_v<U> {
+        U value;
+        read_bytes(&value, sizeof(U));
+        return value;
+    }
+
+    // Bytes left in the input, or SIZE_MAX when its length is unknown.
+    size_t available() const noexcept {
+        return m_unread == SIZE_MAX ? SIZE_MAX : m_unread + (m_end - m_pos);
+    }
+
+    // Reads a length prefix for items of at least item_bytes bytes each,
+    // rejecting counts the rest of the input cannot hold.
+    size_t read_count(size_t item_bytes) {
+        uint64_t count = read_value<uint64_t>();
+        if (item_bytes > 0 && count > available() / item_bytes) {
+            throw VectorException("unexpected end of file: length prefix exceeds the remaining input");
+        }
+        return static_cast<size_t>(count);
+    }
+
+    // Appends count values to out. Input of unknown length is read in
+    // buffer-sized pieces, so out grows only as the data actually arrives.
+    template <typename U>
+    void read_values(Vector<U>& out, size_t count) requires std::is_trivially_copyable_v<U> {
+        size_t piece = available() == SIZE_MAX ? (buffer_size + sizeof(U) - 1) / sizeof(U) : count;
+        for (size_t done = 0; done < count;) {
+            size_t n = count - done < piece ? count - done : piece;
+            read_bytes(out.append_uninitialized(n), n * sizeof(U));
+            done += n;
+        }
+    }
+
+    void finish() noexcept {
+        if (m_pos < m_end) {
+            ::lseek(m_fd, -static_cast<off_t>(m_end - m_pos), SEEK_CUR);
+        }
+        m_pos = m_end = 0;
+    }
+};
+
+// Customization point for element types that are not trivially copyable.
+// Specializations provide
+//     static void write(BinaryWriter&, const T&);
+//     static T read(BinaryReader&);
+template <typename T>
+struct VectorSerializer;
+
+template <>
+struct VectorSerializer<std::string> {
+    static void write(BinaryWriter& out, const std::string& value) {
+        out.write_value<uint64_t>(value.size());
+        out.write_bytes(value.data(), value.size());
+    }
+
+    static std::string read(BinaryReader& in) {
+        size_t length = in.read_count(1);
+        size_t piece = in.available() == SIZE_MAX ? ics_detail::max_initial_reserve : length;
+        std::string value;
+        for (size_t done = 0; done < length;) {
+            size_t n = std::min(length - done, piece);
+            value.resize(done + n);
+            in.read_bytes(value.data() + done, n);
+            done += n;
+        }
+        return value;
+    }
+};
+
+template <typename T>
+concept HasVectorSerializer = requires(BinaryWriter& out, BinaryReader& in, const T& value) {
+    VectorSerializer<T>::write(out, value);
+    { VectorSerializer<T>::read(in) } -> std::same_as<T>;
+};
+
+template <typename T>
+concept BinarySerializable = std::is_trivially_copyable_v<T> || HasVectorSerializer<T>;
+
+template <BinarySerializable U>
+struct VectorSerializer<Vector<U>> {
+    static void write(BinaryWriter& out, const Vector<U>& value) {
+        out.write_value<uint64_t>(value.size());
+        if constexpr (std::is_trivially_copyable_v<U>) {
+            out.write_bytes(value.data(), value.size() * sizeof(U));
+        } else {
+            for (const U& element : value) {
+                VectorSerializer<U>::write(out, element);
+            }
+        }
+    }
+
+    static Vector<U> read(BinaryReader& in) {
+        Vector<U> value;
+        if constexpr (std::is_trivially_copyable_v<U>) {
+            size_t count = in.read_count(sizeof(U));
+            in.read_values(value, count);
+        } else {
+            size_t count = in.read_count(0);
+            value.resize(std::min(count, ics_detail::max_initial_reserve));
+            for (size_t i = 0; i < count; ++i) {
+                value.push_back(VectorSerializer<U>::read(in));
+            }
+        }
+        return value;
+    }
+};
+
+namespace ics_detail {
+    template <typename T>
+    BinaryHeader make_binary_header(size_t count) noexcept {
+        BinaryHeader header{};
+        std::memcpy(header.magic, BinaryHeader::magic_bytes, sizeof(header.magic));
+        header.version = BinaryHeader::current_version;
+        header.type_tag = static_cast<uint8_t>(vector_type_tag<T>());
+        header.flags = std::endian::native == std::endian::big ? BinaryHeader::flag_big_endian : 0;
+        header.element_size = std::is_trivially_copyable_v<T> ? static_cast<uint32_t>(sizeof(T)) : 0;
+        header.count = count;
+        return header;
+    }
+
+    // Validates header for element type T and returns the element count.
+    template <typename T>
+    size_t check_binary_header(const BinaryHeader& header) {
+        if (std::memcmp(header.magic, BinaryHeader::magic_bytes, sizeof(header.magic)) != 0) {
+            throw VectorException("not a binary vector file");
+        }
+        if (header.version == 0 || header.version > BinaryHeader::current_version) {
+            throw VectorException("unsupported binary vector version " + std::to_string(header.version));
+        }
+        BinaryHeader expected = make_binary_header<T>(0);
+        if ((header.flags & BinaryHeader::flag_big_endian) != expected.flags) {
+            throw VectorException("binary vector byte order mismatch");
+        }
+        if (header.type_tag != expected.type_tag || header.element_size != expected.element_size) {
+            throw VectorException("binary vector element type mismatch");
+        }
+        if (expected.element_size > 0 && header.count > SIZE_MAX / expected.element_size) {
+            throw VectorException("binary vector count is too large");
+        }
+        return static_cast<size_t>(header.count);
+    }
+}
+
+// Writes vec to fd. Trivially copyable contents go out with the header in a
+// single writev; other types stream through a buffered BinaryWriter.
+template <BinarySerializable T>
+void write_binary(int fd, const Vector<T>& vec) {
+    BinaryHeader header = ics_detail::make_binary_header<T>(vec.size());
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        struct iovec iov[2] = {
+            {&header, sizeof(header)},
+            {const_cast<T*>(vec.data()), vec.size() * sizeof(T)},
+        };
+        ics_detail::write_all_v(fd, iov, 2);
+    } else {
+        BinaryWriter out(fd);
+        out.write_value(header);
+        for (const T& element : vec) {
+            VectorSerializer<T>::write(out, element);
+        }
+        out.flush();
+    }
+}
+
+namespace ics_detail {
+    // Appends count elements stored as raw bytes at the position of fd to
+    // out. In a regular file they are checked against the file length and
+    // read with one read; input of unknown length is read in pieces.
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void read_raw_elements(int fd, Vector<T>& out, size_t count) {
+        size_t remaining = remaining_bytes(fd);
+        if (remaining == SIZE_MAX) {
+            BinaryReader in(fd);
+            in.read_values(out, count);
+            in.finish();
+            return;
+        }
+        if (count > remaining / sizeof(T)) {
+            throw VectorException("unexpected end of file: binary vector count exceeds the file");
+        }
+        read_exact(fd, out.append_uninitialized(count), count * sizeof(T));
+    }
+}
+
+// Reads a Vector written by write_binary. Trivially copyable contents are
+// checked against the file length, then read with a single read straight
+// into the Vector's buffer.
+template <BinarySerializable T>
+Vector<T> read_binary(int fd) {
+    BinaryHeader header;
+    ics_detail::read_exact(fd, &header, sizeof(header));
+    size_t count = ics_detail::check_binary_header<T>(header);
+    if (header.flags & BinaryHeader::flag_compressed) {
+        throw VectorException("compressed binary vector needs read_compressed");
+    }
+
+    Vector<T> result;
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        ics_detail::read_raw_elements(fd, result, count);
+    } else {
+        BinaryReader in(fd);
+        result.resize(std::min(count, ics_detail::max_initial_reserve));
+        for (size_t i = 0; i < count; ++i) {
+            result.push_back(VectorSerializer<T>::read(in));
+        }
+        in.finish();
+    }
+    return result;
+}
+
+template <BinarySerializable T>
+void save_binary(const Vector<T>& vec, const std::string& path) {
+    ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_WRONLY | O_CREAT | O_TRUNC);
+    write_binary(fd.get(), vec);
+}
+
+template <BinarySerializable T>
+Vector<T> load_binary(const std::string& path) {
+    ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_RDONLY);
+    return read_binary<T>(fd.get());
+}
+
+#endif
@@ -0,0 +1,134 @@
+#include <ics_arrow.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <cstring>
+
+namespace {
+    int released = 0;
+
+    void count_release(ArrowArray* array) {
+        ++released;
+        array->release = nullptr;
+    }
+
+    TEST_CASE("Arrow export exposes the Vector buffer", "[arrow]") {
+        Vector<int32_t> vec;
+        for (int32_t v : {1, 2, 3, 4}) vec.push_back(v);
+        const int32_t* original = vec.data();
+
+        ArrowArray array;
+        ArrowSchema schema;
+        export_arrow(std::move(vec), &array, &schema);
+
+        CHECK(std::strcmp(schema.format, "i") == 0);
+        CHECK(schema.flags == 0);
+        CHECK(array.length == 4);
+        CHECK(array.null_count == 0);
+        CHECK(array.n_buffers == 2);
+        CHECK(array.buffers[0] == nullptr);
+        CHECK(array.buffers[1] == original);
+
+        array.release(&array);
+        schema.release(&schema);
+        CHECK(array.release == nullptr);
+        CHECK(schema.release == nullptr);
+    }
+
+    TEST_CASE("Arrow round trip is zero-copy", "[arrow]") {
+        Vector<double> vec;
+        for (int i = 0; i < 1000; ++i) vec.push_back(i * 0.5);
+        Vector<double> expected = vec;
+        const double* original = vec.data();
+
+        ArrowArray array;
+        ArrowSchema schema;
+        export_arrow(std::move(vec), &array, &schema);
+        {
+            ArrowVectorView<double> view(&array, &schema);
+            CHECK(array.release == nullptr);
+            CHECK(view.data() == original);
+            CHECK(view.size() == 1000);
+            CHECK(view[10] == 5.0);
+            CHECK(view == expected);
+            CHECK(view.to_vector() == expected);
+            CHECK_THROWS_AS(view.at(1000), VectorException);
+
+            ArrowVectorView<double> moved(std::move(view));
+            CHECK(moved.data() == original);
+            CHECK(view.empty());
+        }
+        schema.release(&schema);
+    }
+
+    TEST_CASE("Arrow import rejects mismatched formats", "[arrow]") {
+        Vector<uint16_t> vec;
+        vec.push_back(7);
+
+        ArrowArray array;
+        ArrowSchema schema;
+        export_arrow(std::move(vec), &array, &schema);
+        CHECK(std::strcmp(schema.format, "S") == 0);
+
+        CHECK_THROWS_AS(ArrowVectorView<int16_t>(&array, &schema), VectorException);
+        // ownership stays with the caller after a failed import
+        REQUIRE(array.release != nullptr);
+        ArrowVectorView<uint16_t> view(&array, &schema);
+        CHECK(view[0] == 7);
+        schema.release(&schema);
+    }
+
+    TEST_CASE("Arrow import rejects malformed schemas and arrays", "[arrow]") {
+        int32_t values[] = {1, 2};
+        const void* buffers[] = {nullptr, values};
+        ArrowArray array{2, 0, 0, 2, 0, buffers, nullptr, nullptr, count_release, nullptr};
+        ArrowSchema schema{nullptr, nullptr, nullptr, 0, 0, nullptr, nullptr, nullptr, nullptr};
+
+        CHECK_THROWS_AS(ArrowVectorView<int32_t>(&array, &schema), VectorException);
+        CHECK_THROWS_AS(ArrowVectorView<int32_t>(&array, nullptr), VectorException);
+        schema.format = "i";
+        array.buffers = nullptr;
+        CHECK_THROWS_AS(ArrowVectorView<int32_t>(&array, &schema), VectorException);
+        REQUIRE(array.release != nullptr);
+        array.buffers = buffers;
+        CHECK(ArrowVectorView<int32_t>(&array, &schema)[1] == 2);
+    }
+
+    TEST_CASE("Arrow import honours offset and release", "[arrow]") {
+        int64_t values[] = {10, 20, 30, 40, 50};
+        const void* buffers[] = {nullptr, values};
+        ArrowArray array{3, 0, 2, 2, 0, buffers, nullptr, nullptr, count_release, nullptr};
+        ArrowSchema schema{"l", nullptr, nullptr, 0, 0, nullptr, nullptr, nullptr, nullptr};
+
+        released = 0;
+        {
+            ArrowVectorView<int64_t> view(&array, &schema);
+            CHECK(view.size() == 3);
+            CHECK(view[0] == 30);
+            CHECK(view.at(2) == 50);
+            CHECK(released == 0);
+        }
+        CHECK(released == 1);
+    }
+
+    TEST_CASE("Arrow export of NullableVector carries validity", "[arrow]") {
+        NullableVector<float> vec;
+        vec.push_back(1.0f);
+        vec.push_back(std::nullopt);
+        vec.push_back(3.0f);
+
+        ArrowArray array;
+        ArrowSchema schema;
+        export_arrow(std::move(vec), &array, &schema);
+
+        CHECK(std::strcmp(schema.format, "f") == 0);
+        CHECK(schema.flags == ARROW_FLAG_NULLABLE);
+        CHECK(array.null_count == 1);
+        REQUIRE(array.buffers[0] != nullptr);
+        CHECK(*static_cast<const unsigned char*>(array.buffers[0]) == 0x05);
+        CHECK(static_cast<const float*>(array.buffers[1])[2] == 3.0f);
+        CHECK_THROWS_AS(ArrowVectorView<float>(&array, &schema), VectorException);
+
+        array.release(&array);
+        schema.release(&schema);
+    }
+}
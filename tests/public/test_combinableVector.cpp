@@ -0,0 +1,79 @@
+#include <ics_combinable_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace {
+    TEST_CASE("CombinableVector gives each thread its own Vector", "[combinable-vector]") {
+        CombinableVector<int64_t> combinable;
+        Vector<int64_t>& mine = combinable.local();
+        mine.push_back(-1);
+        CHECK(&combinable.local() == &mine);
+
+        constexpr int threads = 6;
+        constexpr int per_thread = 100000;
+        Vector<std::thread> pool;
+        for (int t = 0; t < threads; ++t) {
+            pool.push_back(std::thread([&combinable, t] {
+                for (int i = 0; i < per_thread; ++i) combinable.local().push_back(int64_t{t} * per_thread + i);
+            }));
+        }
+        for (std::thread& thread : pool) thread.join();
+
+        CHECK(combinable.threads() == threads + 1);
+        CHECK(combinable.size() == threads * per_thread + 1);
+        ThreadPool workers(4);
+        Vector<int64_t> all = combinable.combine(&workers);
+        REQUIRE(all.size() == threads * per_thread + 1);
+        CHECK(all[0] == -1);
+
+        // each thread's values stay contiguous and in order
+        Vector<int> seen;
+        for (int t = 0; t < threads; ++t) seen.push_back(0);
+        bool ordered = true;
+        for (size_t i = 1; i < all.size(); ++i) {
+            int64_t value = all[i];
+            if (value % per_thread == 0) {
+                ++seen[static_cast<size_t>(value / per_thread)];
+            } else {
+                ordered = ordered && all[i - 1] == value - 1;
+            }
+        }
+        CHECK(ordered);
+        bool each_once = true;
+        for (int count : seen) each_once = each_once && count == 1;
+        CHECK(each_once);
+        ThreadPool serial(1);
+        CHECK(combinable.combine(&serial) == all);
+
+        combinable.clear();
+        CHECK(combinable.size() == 0);
+        CHECK(combinable.combine().empty());
+    }
+
+    TEST_CASE("CombinableVector combines non-trivial elements", "[combinable-vector]") {
+        CombinableVector<std::string> words;
+        std::thread other([&] {
+            words.local().push_back("b");
+            words.local().push_back("c");
+        });
+        other.join();
+        words.local().push_back("a");
+        Vector<std::string> combined = words.combine();
+        REQUIRE(combined.size() == 3);
+        CHECK(combined[0] == "b");
+        CHECK(combined[1] == "c");
+        CHECK(combined[2] == "a");
+
+        // several instances on one thread do not mix up their slots
+        CombinableVector<std::string> more;
+        more.local().push_back("x");
+        words.local().push_back("d");
+        more.local().push_back("y");
+        CHECK(more.combine().size() == 2);
+        CHECK(more.local()[1] == "y");
+        CHECK(words.combine().size() == 4);
+    }
+}
@@ -0,0 +1,222 @@
+#include <ics_compressed_io.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+
+namespace {
+    std::string temp_path(const std::string& name) {
+        return (std::filesystem::temp_directory_path() / ("ics_compressed_io_" + name)).string();
+    }
+
+    // Overwrites one byte of the file at offset with its complement.
+    void corrupt_byte(const std::string& path, size_t offset) {
+        ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_RDWR);
+        unsigned char byte;
+        REQUIRE(::pread(fd.get(), &byte, 1, static_cast<off_t>(offset)) == 1);
+        byte = static_cast<unsigned char>(~byte);
+        REQUIRE(::pwrite(fd.get(), &byte, 1, static_cast<off_t>(offset)) == 1);
+    }
+
+    void patch_u64(const std::string& path, size_t offset, uint64_t value) {
+        ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_RDWR);
+        REQUIRE(::pwrite(fd.get(), &value, sizeof(value), static_cast<off_t>(offset)) == sizeof(value));
+    }
+
+    Vector<unsigned char> lz_round_trip(const Vector<unsigned char>& input) {
+        Vector<unsigned char> packed;
+        unsigned char* out = packed.append_uninitialized(ics_detail::lz_bound(input.size()));
+        size_t size = ics_detail::lz_compress(input.data(), input.size(), out);
+        CHECK(size <= ics_detail::lz_bound(input.size()));
+
+        Vector<unsigned char> unpacked;
+        unsigned char* target = unpacked.append_uninitialized(input.size());
+        CHECK(ics_detail::lz_decompress(packed.data(), size, target, input.size()));
+        if (size > 16) {
+            CHECK_FALSE(ics_detail::lz_decompress(packed.data(), size / 2, target, input.size()));
+        }
+        return unpacked;
+    }
+
+    struct Sample {
+        int32_t id;
+        float weight;
+
+        bool operator==(const Sample&) const = default;
+    };
+
+    TEST_CASE("crc32c matches the Castagnoli check value", "[compressed-io]") {
+        const char digits[] = "123456789";
+        CHECK(crc32c(digits, 9) == 0xE3069283u);
+        CHECK(crc32c(digits + 4, 5, crc32c(digits, 4)) == 0xE3069283u);
+        CHECK(crc32c(digits, 0) == 0);
+
+        std::string text(1000, '\0');
+        for (size_t i = 0; i < text.size(); ++i) text[i] = static_cast<char>(i * 131);
+        uint32_t table = ~ics_detail::crc32c_software(~0u, reinterpret_cast<const unsigned char*>(text.data()),
+                                                       text.size());
+        CHECK(crc32c(text.data(), text.size()) == table);
+    }
+
+    TEST_CASE("LZ codec round trips all kinds of input", "[compressed-io]") {
+        std::mt19937 rng(3);
+        Vector<unsigned char> random;
+        Vector<unsigned char> zeros;
+        Vector<unsigned char> pattern;
+        for (int i = 0; i < 200000; ++i) {
+            random.push_back(static_cast<unsigned char>(rng()));
+            zeros.push_back(0);
+            pattern.push_back(static_cast<unsigned char>("abcabcabd"[i % 9]));
+        }
+        CHECK(lz_round_trip(random) == random);
+        CHECK(lz_round_trip(zeros) == zeros);
+        CHECK(lz_round_trip(pattern) == pattern);
+
+        Vector<unsigned char> tiny;
+        for (int n = 0; n < 40; ++n) {
+            CHECK(lz_round_trip(tiny) == tiny);
+            tiny.push_back(static_cast<unsigned char>(n % 3));
+        }
+
+        Vector<unsigned char> packed;
+        size_t size = ics_detail::lz_compress(zeros.data(), zeros.size(),
+                                              packed.append_uninitialized(ics_detail::lz_bound(zeros.size())));
+        CHECK(size < 1000);
+    }
+
+    TEST_CASE("LZ decoder rejects malformed input", "[compressed-io]") {
+        unsigned char out[16];
+        // match offset reaching before the start of the output
+        const unsigned char back[] = {0x10, 'a', 0x05, 0x00};
+        CHECK_FALSE(ics_detail::lz_decompress(back, sizeof(back), out, sizeof(out)));
+        // literal run longer than the input
+        const unsigned char overrun[] = {0xF0, 0x20, 'a'};
+        CHECK_FALSE(ics_detail::lz_decompress(overrun, sizeof(overrun), out, sizeof(out)));
+        // more output than the caller expects
+        const unsigned char extra[] = {0x10, 'a', 0x01, 0x00, 0x0F, 0xFF};
+        CHECK_FALSE(ics_detail::lz_decompress(extra, sizeof(extra), out, 4));
+    }
+
+    TEST_CASE("Byte shuffle is its own inverse", "[compressed-io]") {
+        Vector<uint32_t> values;
+        for (uint32_t i = 0; i < 1000; ++i) values.push_back(i * 2654435761u);
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values.data());
+        size_t n = values.size() * sizeof(uint32_t);
+
+        Vector<unsigned char> shuffled;
+        ics_detail::byte_shuffle(bytes, n, 4, shuffled.append_uninitialized(n));
+        CHECK(shuffled[1] == bytes[4]);
+        CHECK(shuffled[1000] == bytes[1]);
+        Vector<uint32_t> restored;
+        ics_detail::byte_unshuffle(shuffled.data(), n, 4,
+                                   reinterpret_cast<unsigned char*>(restored.append_uninitialized(values.size())));
+        CHECK(restored == values);
+    }
+
+    TEST_CASE("Compressed format round trips vectors", "[compressed-io]") {
+        std::string path = temp_path("round_trip.bin");
+        Vector<int64_t> stamps;
+        for (int64_t i = 0; i < 300000; ++i) stamps.push_back(1700000000000 + i * 1000 + i % 7);
+
+        ThreadPool pool(4);
+        ThreadPool serial(1);
+        CompressionOptions options;
+        options.block_size = 64 * 1024;
+        options.pool = &pool;
+        save_compressed(stamps, path, options);
+        CHECK(std::filesystem::file_size(path) < stamps.size() * sizeof(int64_t) / 4);
+        Vector<int64_t> loaded = load_compressed<int64_t>(path, &pool);
+        CHECK(loaded == stamps);
+        CHECK(loaded.capacity() == loaded.size());
+
+        options.shuffle = false;
+        save_compressed(stamps, path, options);
+        CHECK(load_compressed<int64_t>(path, &serial) == stamps);
+
+        std::mt19937_64 rng(5);
+        Vector<double> noise;
+        for (int i = 0; i < 50000; ++i) noise.push_back(std::generate_canonical<double, 53>(rng));
+        save_compressed(noise, path);
+        CHECK(load_compressed<double>(path) == noise);
+
+        Vector<Sample> samples;
+        for (int i = 0; i < 1000; ++i) samples.push_back(Sample{i, 0.5f});
+        save_compressed(samples, path, CompressionOptions{100, &pool, true});
+        CHECK((load_compressed<Sample>(path) == samples));
+
+        save_compressed(Vector<float>(), path);
+        CHECK(load_compressed<float>(path).empty());
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("Compressed and plain binary files are told apart", "[compressed-io]") {
+        std::string path = temp_path("flags.bin");
+        Vector<int> values;
+        for (int i = 0; i < 1000; ++i) values.push_back(i);
+
+        save_compressed(values, path);
+        CHECK_THROWS_WITH(load_binary<int>(path), Catch::Matchers::ContainsSubstring("read_compressed"));
+        CHECK_THROWS_WITH(load_compressed<long>(path), Catch::Matchers::ContainsSubstring("type mismatch"));
+
+        save_binary(values, path);
+        CHECK(load_compressed<int>(path) == values);
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("Compressed format detects corruption", "[compressed-io]") {
+        std::string path = temp_path("corrupt.bin");
+        Vector<int32_t> values;
+        for (int32_t i = 0; i < 100000; ++i) values.push_back(i / 3);
+        CompressionOptions options;
+        options.block_size = 16 * 1024;
+        size_t blocks = (values.size() * sizeof(int32_t) + options.block_size - 1) / options.block_size;
+        size_t payload = sizeof(BinaryHeader) + blocks * sizeof(CompressedBlock) + sizeof(uint32_t);
+
+        save_compressed(values, path, options);
+        corrupt_byte(path, payload + 10);
+        CHECK_THROWS_WITH(load_compressed<int32_t>(path), Catch::Matchers::ContainsSubstring("checksum mismatch"));
+
+        save_compressed(values, path, options);
+        corrupt_byte(path, sizeof(BinaryHeader) + 1);
+        CHECK_THROWS_WITH(load_compressed<int32_t>(path), Catch::Matchers::ContainsSubstring("table checksum"));
+
+        save_compressed(values, path, options);
+        corrupt_byte(path, offsetof(BinaryHeader, extra));
+        CHECK_THROWS_WITH(load_compressed<int32_t>(path), Catch::Matchers::ContainsSubstring("corrupt"));
+
+        save_compressed(values, path, options);
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+        CHECK_THROWS_WITH(load_compressed<int32_t>(path), Catch::Matchers::ContainsSubstring("end of file"));
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("Compressed format rejects sizes the file cannot hold", "[compressed-io]") {
+        std::string path = temp_path("sizes.bin");
+        Vector<int32_t> values;
+        for (int32_t i = 0; i < 10000; ++i) values.push_back(i);
+        CompressionOptions options;
+        options.block_size = 4096;
+
+        // a consistent header whose block table runs past the end
+        save_compressed(values, path, options);
+        uint64_t count = uint64_t{1} << 40;
+        patch_u64(path, offsetof(BinaryHeader, count), count);
+        patch_u64(path, offsetof(BinaryHeader, extra), (count * sizeof(int32_t) + 4095) / 4096);
+        CHECK_THROWS_WITH(load_compressed<int32_t>(path), Catch::Matchers::ContainsSubstring("end of file"));
+
+        // a block of a few hundred bytes cannot decode to a whole megabyte
+        options.block_size = size_t{1} << 20;
+        Vector<int32_t> zeros;
+        for (int32_t i = 0; i < 10000; ++i) zeros.push_back(0);
+        save_compressed(zeros, path, options);
+        patch_u64(path, offsetof(BinaryHeader, count), options.block_size / sizeof(int32_t));
+        CHECK_THROWS_WITH(load_compressed<int32_t>(path), Catch::Matchers::ContainsSubstring("corrupt compressed vector block table"));
+
+        save_binary(values, path);
+        patch_u64(path, offsetof(BinaryHeader, count), uint64_t{1} << 40);
+        CHECK_THROWS_WITH(load_compressed<int32_t>(path), Catch::Matchers::ContainsSubstring("end of file"));
+        std::remove(path.c_str());
+    }
+}
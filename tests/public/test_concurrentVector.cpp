@@ -0,0 +1,89 @@
+#include <ics_concurrent_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace {
+    TEST_CASE("ConcurrentVector appends like a Vector", "[concurrent-vector]") {
+        ConcurrentVector<std::string> v(3);
+        CHECK(v.empty());
+        CHECK_FALSE(v.published(0));
+        for (int i = 0; i < 1000; ++i) CHECK(v.push_back(std::to_string(i)) == static_cast<size_t>(i));
+        CHECK(v.size() == 1000);
+        CHECK(v[999] == "999");
+        CHECK(v.at(4) == "4");
+        CHECK_THROWS_AS(v.at(1000), VectorException);
+
+        std::string* first = &v[0];
+        v.reserve(100000);
+        CHECK(&v[0] == first);
+
+        ConcurrentVector<std::string>::Range range = v.grow_by(3, "x");
+        CHECK(range.first() == 1000);
+        CHECK(range.size() == 3);
+        for (std::string& value : range) value += "y";
+        CHECK(v[1002] == "xy");
+        CHECK(v.emplace_back(2, 'z') == 1003);
+        CHECK(v.to_vector()[1003] == "zz");
+
+        size_t count = 0;
+        for (const std::string& value : v) count += !value.empty();
+        CHECK(count == 1004);
+        v.clear();
+        CHECK(v.empty());
+        v.push_back("again");
+        CHECK(v[0] == "again");
+    }
+
+    TEST_CASE("ConcurrentVector takes appends from many threads", "[concurrent-vector]") {
+        constexpr int threads = 8;
+        constexpr int per_thread = 20000;
+        ConcurrentVector<int> v(16);
+        std::atomic<bool> done{false};
+        std::atomic<int> bad_reads{0};
+
+        std::thread reader([&] {
+            while (!done.load()) {
+                size_t n = v.size();
+                for (size_t i = n > 64 ? n - 64 : 0; i < n; ++i) {
+                    if (v.published(i) && v[i] < -1) bad_reads.fetch_add(1);
+                }
+            }
+        });
+        Vector<std::thread> writers;
+        for (int t = 0; t < threads; ++t) {
+            writers.push_back(std::thread([&v, t] {
+                for (int i = 0; i < per_thread; ++i) {
+                    if (i % 100 == 0) {
+                        v.grow_by(4, -1);
+                    } else {
+                        v.push_back(t * per_thread + i);
+                    }
+                }
+            }));
+        }
+        for (std::thread& writer : writers) writer.join();
+        done.store(true);
+        reader.join();
+
+        REQUIRE(v.size() == static_cast<size_t>(threads * per_thread + threads * per_thread / 100 * 3));
+        Vector<int> seen;
+        seen.resize(threads * per_thread);
+        for (int i = 0; i < threads * per_thread; ++i) seen.push_back(0);
+        size_t fillers = 0;
+        for (int value : v) {
+            if (value == -1) {
+                ++fillers;
+            } else {
+                ++seen[static_cast<size_t>(value)];
+            }
+        }
+        bool each_once = true;
+        for (size_t i = 0; i < seen.size(); ++i) each_once = each_once && seen[i] == (i % per_thread % 100 != 0);
+        CHECK(each_once);
+        CHECK(fillers == static_cast<size_t>(threads * per_thread / 100 * 4));
+        CHECK(bad_reads.load() == 0);
+    }
+}
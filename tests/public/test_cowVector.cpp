@@ -0,0 +1,130 @@
+#include <ics_cow_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace {
+    TEST_CASE("CowVector behaves like a Vector", "[cow-vector]") {
+        CowVector<int> cow(100);
+        CHECK(cow.chunk_size() == 128);
+        CHECK(cow.empty());
+        Vector<int> expected;
+        for (int i = 0; i < 1000; ++i) {
+            cow.push_back(i);
+            expected.push_back(i);
+        }
+        CHECK(cow.size() == 1000);
+        CHECK(cow == expected);
+        CHECK(cow[999] == 999);
+        CHECK(cow.at(500) == 500);
+        CHECK_THROWS_AS(cow.at(1000), VectorException);
+
+        cow[3] = -3;
+        cow.set(700, -700);
+        cow.at(128) += 1;
+        expected[3] = -3;
+        expected[700] = -700;
+        expected[128] += 1;
+        CHECK(cow.to_vector() == expected);
+
+        for (int i = 0; i < 200; ++i) {
+            cow.pop_back();
+            expected.pop_back();
+        }
+        CHECK(cow == expected);
+        cow.clear();
+        CHECK(cow.empty());
+        CHECK_THROWS_AS(cow.pop_back(), VectorException);
+    }
+
+    TEST_CASE("Moved-from CowVectors stay usable", "[cow-vector]") {
+        CowVector<int> source(4);
+        for (int i = 0; i < 10; ++i) source.push_back(i);
+        CowSnapshot<int> shared = source.snapshot();
+
+        CowVector<int> moved(std::move(source));
+        CHECK(moved.size() == 10);
+        CHECK(moved[9] == 9);
+        CHECK(source.size() == 0);
+        source.push_back(42);
+        CHECK(source.size() == 1);
+        CHECK(source[0] == 42);
+
+        CowVector<int> assigned;
+        assigned.push_back(-1);
+        assigned = std::move(moved);
+        CHECK(assigned.size() == 10);
+        CHECK(assigned.chunk_size() == 4);
+        CHECK(moved.empty());
+        moved.push_back(7);
+        moved[0] = 8;
+        CHECK(moved.size() == 1);
+        CHECK(moved.at(0) == 8);
+        CHECK(shared.size() == 10);
+    }
+
+    TEST_CASE("Snapshots are frozen and share unchanged chunks", "[cow-vector]") {
+        CowVector<std::string> cow(4);
+        for (int i = 0; i < 16; ++i) cow.push_back(std::to_string(i));
+        CHECK(cow.shared_chunks() == 0);
+
+        CowSnapshot<std::string> before = cow.snapshot();
+        CHECK(cow.shared_chunks() == 4);
+        cow[5] = "five";
+        cow.push_back("16");
+        CHECK(cow.shared_chunks() == 3);
+        CHECK(before.size() == 16);
+        CHECK(before[5] == "5");
+        CHECK(cow[5] == "five");
+        CHECK(&before[0] == &cow.snapshot()[0]);
+        CHECK(&before[4] != &cow.snapshot()[4]);
+
+        CowSnapshot<std::string> copy = before;
+        before = CowSnapshot<std::string>();
+        CHECK(before.empty());
+        CHECK(copy[15] == "15");
+
+        std::string joined;
+        for (const std::string& value : copy) joined += value;
+        CHECK(joined == "0123456789101112131415");
+        size_t chunks = 0;
+        copy.for_each_chunk([&](const std::string*, size_t count) {
+            CHECK(count == 4);
+            ++chunks;
+        });
+        CHECK(chunks == 4);
+    }
+
+    TEST_CASE("Readers iterate snapshots while the writer mutates", "[cow-vector]") {
+        CowVector<long> cow(64);
+        for (long i = 0; i < 4096; ++i) cow.push_back(0);
+
+        // every snapshot holds one value in all slots
+        std::atomic<bool> done{false};
+        std::atomic<int> torn{0};
+        CowSnapshot<long> shared = cow.snapshot();
+        std::atomic<CowSnapshot<long>*> latest{new CowSnapshot<long>(shared)};
+        std::thread reader([&] {
+            while (!done.load()) {
+                CowSnapshot<long>* snapshot = latest.exchange(nullptr);
+                if (snapshot == nullptr) continue;
+                long first = (*snapshot)[0];
+                for (long value : *snapshot) {
+                    if (value != first) torn.fetch_add(1);
+                }
+                delete snapshot;
+            }
+        });
+        for (long round = 1; round <= 200; ++round) {
+            for (size_t i = 0; i < cow.size(); ++i) cow[i] = round;
+            delete latest.exchange(new CowSnapshot<long>(cow.snapshot()));
+        }
+        done.store(true);
+        reader.join();
+        delete latest.exchange(nullptr);
+        CHECK(torn.load() == 0);
+        CHECK(shared[4095] == 0);
+    }
+}
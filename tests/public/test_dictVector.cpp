@@ -0,0 +1,71 @@
+#include <ics_dict_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <string>
+
+namespace {
+    TEST_CASE("DictVector stores repeated values once", "[dict-vector]") {
+        DictVector<std::string> dict;
+        for (int i = 0; i < 30; ++i) {
+            dict.push_back(i % 3 == 0 ? "ok" : (i % 3 == 1 ? "warn" : "error"));
+        }
+
+        CHECK(dict.size() == 30);
+        CHECK(dict.cardinality() == 3);
+        CHECK(dict.code_width() == 1);
+        CHECK(dict[0] == "ok");
+        CHECK(dict[1] == "warn");
+        CHECK(dict.at(29) == "error");
+        CHECK(dict.code(0) == dict.code(3));
+        CHECK_THROWS_AS(dict.at(30), VectorException);
+    }
+
+    TEST_CASE("DictVector widens codes with cardinality", "[dict-vector]") {
+        DictVector<int> dict;
+        for (int i = 0; i < 256; ++i) dict.push_back(i);
+        CHECK(dict.code_width() == 1);
+
+        dict.push_back(256);
+        CHECK(dict.code_width() == 2);
+
+        for (int i = 257; i < 70000; ++i) dict.push_back(i);
+        CHECK(dict.code_width() == 4);
+        CHECK(dict.cardinality() == 70000);
+
+        for (int i = 0; i < 70000; i += 997) {
+            CHECK(dict[i] == i);
+        }
+    }
+
+    TEST_CASE("DictVector equality filters run on codes", "[dict-vector]") {
+        Vector<std::string> column;
+        for (int i = 0; i < 100; ++i) column.push_back(i % 4 == 0 ? "a" : "b");
+
+        DictVector<std::string> dict(column);
+        CHECK(dict.count_equal("a") == 25);
+        CHECK(dict.count_equal("b") == 75);
+        CHECK(dict.count_equal("missing") == 0);
+
+        Vector<size_t> positions = dict.filter_equal("a");
+        CHECK(positions.size() == 25);
+        CHECK(positions[0] == 0);
+        CHECK(positions[24] == 96);
+        CHECK(dict.filter_equal("missing").empty());
+        CHECK_FALSE(dict.find_code("missing").has_value());
+    }
+
+    TEST_CASE("DictVector round trips through Vector", "[dict-vector]") {
+        Vector<int> values;
+        for (int v : {5, 5, 1, 2, 5, 1}) values.push_back(v);
+
+        DictVector<int> dict(values);
+        CHECK(dict.to_vector() == values);
+        CHECK(dict == DictVector<int>(values));
+
+        dict.clear();
+        CHECK(dict.empty());
+        CHECK(dict.cardinality() == 0);
+        dict.push_back(7);
+        CHECK(dict[0] == 7);
+    }
+}
@@ -0,0 +1,77 @@
+#include <ics_mapped_vector.hpp>
+#include <ics_compressed_io.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <numeric>
+#include <string>
+
+namespace {
+    std::string temp_path(const std::string& name) {
+        return (std::filesystem::temp_directory_path() / ("ics_mapped_vector_" + name)).string();
+    }
+
+    TEST_CASE("MappedVectorView reads a binary vector in place", "[mapped-vector]") {
+        std::string path = temp_path("values.bin");
+        Vector<int64_t> values;
+        for (int64_t i = 0; i < 50000; ++i) values.push_back(i * 3 - 7);
+        save_binary(values, path);
+
+        MappedVectorView<int64_t> view(path, AccessPattern::sequential);
+        REQUIRE(view.size() == values.size());
+        CHECK_FALSE(view.empty());
+        CHECK(view[0] == -7);
+        CHECK(view.front() == values.front());
+        CHECK(view.back() == values.back());
+        CHECK(view.at(49999) == values[49999]);
+        CHECK_THROWS_AS(view.at(50000), VectorException);
+        CHECK(std::accumulate(view.begin(), view.end(), int64_t{0})
+              == std::accumulate(values.begin(), values.end(), int64_t{0}));
+
+        CHECK(view == values);
+        CHECK(values == view);
+        CHECK(view == map_binary<int64_t>(path, AccessPattern::random));
+        CHECK(view.to_vector() == values);
+
+        values[10] = 0;
+        CHECK(view != values);
+        view.advise(AccessPattern::will_need, 100, 1000);
+        view.advise(AccessPattern::dont_need, 60000);
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("MappedVectorView handles empty and padded files", "[mapped-vector]") {
+        std::string path = temp_path("padded.bin");
+        save_binary(Vector<float>(), path);
+        MappedVectorView<float> empty(path);
+        CHECK(empty.empty());
+        CHECK(empty.begin() == empty.end());
+
+        Vector<float> values;
+        values.push_back(1.5f);
+        values.push_back(-2.0f);
+        save_binary(values, path);
+        std::filesystem::resize_file(path, 4096);
+        CHECK(map_binary<float>(path) == values);
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("MappedVectorView rejects files it cannot map", "[mapped-vector]") {
+        std::string path = temp_path("bad.bin");
+        Vector<int32_t> values;
+        for (int32_t i = 0; i < 100; ++i) values.push_back(i);
+
+        save_binary(values, path);
+        CHECK_THROWS_WITH(map_binary<uint32_t>(path), Catch::Matchers::ContainsSubstring("type mismatch"));
+        std::filesystem::resize_file(path, sizeof(BinaryHeader) + 99 * sizeof(int32_t));
+        CHECK_THROWS_WITH(map_binary<int32_t>(path), Catch::Matchers::ContainsSubstring("truncated"));
+        std::filesystem::resize_file(path, 10);
+        CHECK_THROWS_WITH(map_binary<int32_t>(path), Catch::Matchers::ContainsSubstring("truncated"));
+
+        save_compressed(values, path);
+        CHECK_THROWS_WITH(map_binary<int32_t>(path), Catch::Matchers::ContainsSubstring("cannot be mapped"));
+        std::remove(path.c_str());
+        CHECK_THROWS_WITH(map_binary<int32_t>(path), Catch::Matchers::ContainsSubstring("cannot open"));
+    }
+}
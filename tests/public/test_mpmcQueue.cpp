@@ -0,0 +1,103 @@
+#include <ics_mpmc_queue.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <thread>
+
+namespace {
+    TEST_CASE("MpmcQueue is a bounded FIFO", "[mpmc-queue]") {
+        MpmcQueue<std::string> queue(3);
+        CHECK(queue.capacity() == 4);
+        std::string out;
+        CHECK_FALSE(queue.try_pop(out));
+        for (int round = 0; round < 3; ++round) {
+            for (int i = 0; i < 4; ++i) CHECK(queue.try_push(std::to_string(i)));
+            CHECK_FALSE(queue.try_push("full"));
+            CHECK(queue.size() == 4);
+            for (int i = 0; i < 4; ++i) {
+                REQUIRE(queue.try_pop(out));
+                CHECK(out == std::to_string(i));
+            }
+        }
+
+        std::string batch[6] = {"a", "b", "c", "d", "e", "f"};
+        CHECK(queue.try_push_n(batch) == 4);
+        std::string got[3];
+        CHECK(queue.try_pop_n(got) == 3);
+        CHECK(got[2] == "c");
+        queue.push("g");
+        CHECK(queue.pop() == "d");
+        CHECK(queue.pop_n(got) == 1);
+        CHECK(got[0] == "g");
+        // nothing to take into: returns instead of waiting for a value
+        CHECK(queue.pop_n(std::span<std::string>()) == 0);
+        queue.push("h");
+        CHECK(queue.pop_n(std::span<std::string>(got, 0)) == 0);
+        CHECK(queue.pop() == "h");
+    }
+
+    TEST_CASE("MpmcQueue delivers every value exactly once", "[mpmc-queue]") {
+        constexpr int producers = 4;
+        constexpr int consumers = 4;
+        constexpr uint32_t per_producer = 50000;
+        MpmcQueue<uint32_t> queue(64);
+        std::atomic<uint8_t>* counts = new std::atomic<uint8_t>[producers * per_producer]();
+        std::atomic<uint32_t> received{0};
+
+        Vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.push_back(std::thread([&queue, p] {
+                uint32_t batch[10];
+                for (uint32_t i = 0; i < per_producer;) {
+                    if (p % 2 == 0) {
+                        queue.push(p * per_producer + i++);
+                        continue;
+                    }
+                    uint32_t n = 0;
+                    for (; n < 10 && i + n < per_producer; ++n) batch[n] = p * per_producer + i + n;
+                    queue.push_n(std::span<uint32_t>(batch, n));
+                    i += n;
+                }
+            }));
+        }
+        for (int c = 0; c < consumers; ++c) {
+            threads.push_back(std::thread([&, c] {
+                uint32_t batch[8];
+                while (received.load() < producers * per_producer) {
+                    size_t n = 0;
+                    if (c % 2 == 0) {
+                        n = queue.try_pop_n(batch);
+                    } else if (queue.try_pop(batch[0])) {
+                        n = 1;
+                    }
+                    for (size_t i = 0; i < n; ++i) counts[batch[i]].fetch_add(1);
+                    received.fetch_add(static_cast<uint32_t>(n));
+                }
+            }));
+        }
+        for (std::thread& thread : threads) thread.join();
+
+        bool exactly_once = true;
+        for (uint32_t i = 0; i < producers * per_producer; ++i) exactly_once = exactly_once && counts[i].load() == 1;
+        delete[] counts;
+        CHECK(exactly_once);
+        CHECK(queue.size() == 0);
+    }
+
+    TEST_CASE("MpmcQueue parks blocked threads until woken", "[mpmc-queue]") {
+        MpmcQueue<int> queue(2);
+        std::thread consumer([&] {
+            int sum = 0;
+            for (int i = 0; i < 1000; ++i) sum += queue.pop();
+            queue.push(sum);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        for (int i = 0; i < 1000; ++i) queue.push(i);
+        consumer.join();
+        CHECK(queue.pop() == 499500);
+    }
+}
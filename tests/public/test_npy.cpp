@@ -0,0 +1,111 @@
+#include <ics_npy.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+    std::string temp_path(const std::string& name) {
+        return (std::filesystem::temp_directory_path() / ("ics_npy_" + name)).string();
+    }
+
+    // Writes a version 1.0 file with a hand-written header dictionary.
+    void write_raw_npy(const std::string& path, const std::string& dict, const std::string& payload) {
+        std::string header = dict;
+        while ((10 + header.size() + 1) % 16 != 0) header.push_back(' ');
+        header.push_back('\n');
+
+        std::ofstream out(path, std::ios::binary);
+        out.write("\x93NUMPY\x01\x00", 8);
+        out.put(static_cast<char>(header.size() & 0xFF));
+        out.put(static_cast<char>(header.size() >> 8));
+        out << header << payload;
+    }
+
+    TEST_CASE("npy save and load round trip", "[npy]") {
+        std::string path = temp_path("roundtrip.npy");
+        Vector<double> values;
+        for (int i = 0; i < 1000; ++i) values.push_back(i * 0.25);
+
+        save_npy(values, path);
+        CHECK(std::filesystem::file_size(path) == 128 + 1000 * sizeof(double));
+        CHECK(load_npy<double>(path) == values);
+
+        Vector<uint8_t> bytes;
+        for (int i = 0; i < 5; ++i) bytes.push_back(static_cast<uint8_t>(i));
+        save_npy(bytes, path);
+        CHECK(load_npy<uint8_t>(path) == bytes);
+
+        save_npy(Vector<int32_t>(), path);
+        CHECK(load_npy<int32_t>(path).empty());
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("npy header describes dtype and shape", "[npy]") {
+        std::string path = temp_path("header.npy");
+        Vector<int16_t> values;
+        values.push_back(-3);
+        save_npy(values, path);
+
+        std::ifstream in(path, std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        CHECK(contents.find("'descr': '<i2'") != std::string::npos);
+        CHECK(contents.find("'shape': (1,)") != std::string::npos);
+        CHECK((contents.find('\n') + 1) % 64 == 0);
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("npy mapped view reads without copying", "[npy]") {
+        std::string path = temp_path("mapped.npy");
+        Vector<float> values;
+        for (int i = 0; i < 100; ++i) values.push_back(static_cast<float>(i));
+        save_npy(values, path);
+
+        NpyView<float> view = map_npy<float>(path);
+        CHECK(view.size() == 100);
+        CHECK(view[42] == 42.0f);
+        CHECK(view.at(99) == 99.0f);
+        CHECK_THROWS_AS(view.at(100), VectorException);
+        CHECK(view.to_vector() == values);
+        CHECK(reinterpret_cast<uintptr_t>(view.data()) % 64 == 0);
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("npy accepts headers written by numpy", "[npy]") {
+        std::string path = temp_path("numpy.npy");
+        int32_t payload[] = {7, 8, 9};
+        write_raw_npy(path, "{'descr': '<i4', 'fortran_order': False, 'shape': (3,), }",
+                      std::string(reinterpret_cast<const char*>(payload), sizeof(payload)));
+
+        Vector<int32_t> loaded = load_npy<int32_t>(path);
+        REQUIRE(loaded.size() == 3);
+        CHECK(loaded[2] == 9);
+        CHECK(map_npy<int32_t>(path)[0] == 7);
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("npy rejects mismatched files", "[npy]") {
+        std::string path = temp_path("bad.npy");
+        std::string payload(64, '\0');
+
+        write_raw_npy(path, "{'descr': '<f4', 'fortran_order': False, 'shape': (4,), }", payload);
+        CHECK_THROWS_WITH(load_npy<double>(path), Catch::Matchers::ContainsSubstring("does not match"));
+        CHECK_THROWS_AS(map_npy<int32_t>(path), VectorException);
+
+        write_raw_npy(path, "{'descr': '>f8', 'fortran_order': False, 'shape': (4,), }", payload);
+        CHECK_THROWS_WITH(load_npy<double>(path), Catch::Matchers::ContainsSubstring("byte order"));
+
+        write_raw_npy(path, "{'descr': '<f8', 'fortran_order': False, 'shape': (2, 2), }", payload);
+        CHECK_THROWS_WITH(load_npy<double>(path), Catch::Matchers::ContainsSubstring("one-dimensional"));
+
+        write_raw_npy(path, "{'descr': '<f8', 'fortran_order': False, 'shape': (100,), }", payload);
+        CHECK_THROWS_WITH(load_npy<double>(path), Catch::Matchers::ContainsSubstring("truncated"));
+
+        std::ofstream(path, std::ios::binary) << "not numpy at all";
+        CHECK_THROWS_WITH(load_npy<double>(path), Catch::Matchers::ContainsSubstring("not an npy file"));
+        CHECK_THROWS_AS(load_npy<double>(temp_path("missing.npy")), VectorException);
+        std::remove(path.c_str());
+    }
+}
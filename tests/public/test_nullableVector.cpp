@@ -0,0 +1,101 @@
+#include <ics_nullable_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <cstring>
+
+namespace {
+    TEST_CASE("NullableVector tracks validity per element", "[nullable-vector]") {
+        NullableVector<double> vec;
+        vec.push_back(1.5);
+        vec.push_back(std::nullopt);
+        vec.push_back(std::optional<double>(2.5));
+
+        CHECK(vec.size() == 3);
+        CHECK(vec.null_count() == 1);
+        CHECK(vec.count() == 2);
+        CHECK(vec.is_valid(0));
+        CHECK(vec.is_null(1));
+        CHECK(vec[1] == 0.0);
+        CHECK(vec.get(2) == 2.5);
+        CHECK_FALSE(vec.get(1).has_value());
+        CHECK_THROWS_AS(vec.at(3), VectorException);
+    }
+
+    TEST_CASE("NullableVector reductions skip nulls", "[nullable-vector]") {
+        NullableVector<int> vec;
+        int expected = 0;
+        for (int i = 0; i < 200; ++i) {
+            if (i % 3 == 0) {
+                vec.push_back(std::nullopt);
+            } else {
+                vec.push_back(i);
+                expected += i;
+            }
+        }
+        // a fully valid bitmap word
+        for (int i = 0; i < 64; ++i) {
+            vec.push_back(-1);
+            expected -= 1;
+        }
+
+        CHECK(vec.sum() == expected);
+        CHECK(vec.min() == -1);
+        CHECK(vec.max() == 199);
+        CHECK(vec.count() == 200 - 67 + 64);
+
+        size_t visited = 0;
+        vec.for_each_valid([&visited](size_t, int) { ++visited; });
+        CHECK(visited == vec.count());
+
+        NullableVector<int> all_null;
+        all_null.push_back(std::nullopt);
+        CHECK(all_null.sum() == 0);
+        CHECK_FALSE(all_null.min().has_value());
+    }
+
+    TEST_CASE("NullableVector bitmap is Arrow ordered", "[nullable-vector]") {
+        NullableVector<int> vec;
+        for (int i = 0; i < 10; ++i) {
+            if (i == 2 || i == 9) {
+                vec.push_back(std::nullopt);
+            } else {
+                vec.push_back(i);
+            }
+        }
+
+        unsigned char bytes[8];
+        std::memcpy(bytes, vec.validity(), sizeof(bytes));
+        CHECK(bytes[0] == 0xFB);
+        CHECK(bytes[1] == 0x01);
+        CHECK(vec.data()[3] == 3);
+    }
+
+    TEST_CASE("NullableVector set, pop and round trip", "[nullable-vector]") {
+        Vector<std::optional<int>> values;
+        for (int i = 0; i < 70; ++i) {
+            values.push_back(i % 2 == 0 ? std::optional<int>(i) : std::nullopt);
+        }
+
+        NullableVector<int> vec(values);
+        CHECK((vec.to_vector() == values));
+
+        vec.set(1, 5);
+        vec.set_null(0);
+        CHECK(vec.get(1) == 5);
+        CHECK(vec.is_null(0));
+        CHECK(vec.null_count() == 35);
+
+        vec.pop_back();
+        vec.pop_back();
+        vec.pop_back();
+        vec.pop_back();
+        vec.pop_back();
+        vec.pop_back();
+        vec.pop_back();
+        CHECK(vec.size() == 63);
+        vec.push_back(1);
+        CHECK(vec.get(63) == 1);
+        CHECK(vec.null_count() == 31);
+        CHECK(vec == NullableVector<int>(vec.to_vector()));
+    }
+}
@@ -0,0 +1,113 @@
+#include <ics_packed_sorted_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace {
+    Vector<uint32_t> sorted_values(size_t n, uint32_t max_gap, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<uint32_t> gap(0, max_gap);
+        Vector<uint32_t> values(n);
+        uint32_t current = gap(rng);
+        for (size_t i = 0; i < n; ++i) {
+            values.push_back(current);
+            current += gap(rng);
+        }
+        return values;
+    }
+
+    TEST_CASE("PackedSortedVector round trips values", "[packed-sorted-vector]") {
+        for (uint32_t max_gap : {0u, 1u, 7u, 1000u, 1u << 21}) {
+            Vector<uint32_t> values = sorted_values(1000, max_gap, max_gap);
+            PackedSortedVector packed(values);
+
+            CHECK(packed.size() == 1000);
+            CHECK(packed.to_vector() == values);
+            CHECK(packed[0] == values[0]);
+            CHECK(packed[517] == values[517]);
+            CHECK(packed.at(999) == values[999]);
+            CHECK(packed.back() == values[999]);
+        }
+    }
+
+    TEST_CASE("PackedSortedVector handles full-width deltas", "[packed-sorted-vector]") {
+        PackedSortedVector packed;
+        for (size_t i = 0; i < 256; ++i) {
+            packed.push_back(i < 4 ? 0 : UINT32_MAX);
+        }
+        CHECK(packed[3] == 0);
+        CHECK(packed[4] == UINT32_MAX);
+        CHECK(packed[255] == UINT32_MAX);
+    }
+
+    TEST_CASE("PackedSortedVector SIMD and scalar decode agree", "[packed-sorted-vector]") {
+        for (uint32_t bits = 0; bits <= 32; ++bits) {
+            uint32_t in[128];
+            std::mt19937 rng(bits);
+            uint32_t widest = 0;
+            for (size_t i = 0; i < 128; ++i) {
+                uint32_t step = static_cast<uint32_t>(rng()) & ics_detail::low_mask(bits);
+                in[i] = i == 0 ? 5 : (i < 4 ? in[0] : in[i - 4]) + step;
+                widest |= in[i] - (i < 4 ? in[0] : in[i - 4]);
+            }
+            uint32_t width = ics_detail::bit_width(widest);
+            uint32_t packed[4 * 32] = {};
+            ics_detail::pack_block(in, width, packed);
+
+            uint32_t scalar[128];
+            uint32_t fast[128];
+            ics_detail::unpack_block_scalar(packed, width, in[0], scalar);
+            ics_detail::unpack_block(packed, width, in[0], fast);
+            CHECK(std::equal(in, in + 128, scalar));
+            CHECK(std::equal(in, in + 128, fast));
+        }
+    }
+
+    TEST_CASE("PackedSortedVector lower_bound matches std::lower_bound", "[packed-sorted-vector]") {
+        Vector<uint32_t> values = sorted_values(5000, 3, 42);
+        PackedSortedVector packed(values);
+
+        const uint32_t* first = values.data();
+        const uint32_t* last = values.data() + values.size();
+        for (uint32_t probe = 0; probe <= values[4999] + 2; probe += 5) {
+            size_t expected = static_cast<size_t>(std::lower_bound(first, last, probe) - first);
+            CHECK(packed.lower_bound(probe) == expected);
+        }
+        CHECK(packed.contains(values[1234]));
+        CHECK_FALSE(packed.contains(values[4999] + 1));
+    }
+
+    TEST_CASE("PackedSortedVector rejects unsorted appends", "[packed-sorted-vector]") {
+        PackedSortedVector packed;
+        packed.push_back(10);
+        CHECK_THROWS_AS(packed.push_back(9), VectorException);
+        CHECK_THROWS_AS(packed.at(1), VectorException);
+    }
+
+    TEST_CASE("PackedSortedVector intersection", "[packed-sorted-vector]") {
+        Vector<uint32_t> dense = sorted_values(20000, 2, 1);
+        Vector<uint32_t> sparse = sorted_values(300, 120, 2);
+
+        Vector<uint32_t> expected;
+        size_t i = 0;
+        size_t j = 0;
+        while (i < dense.size() && j < sparse.size()) {
+            if (dense[i] < sparse[j]) {
+                ++i;
+            } else if (sparse[j] < dense[i]) {
+                ++j;
+            } else {
+                expected.push_back(dense[i]);
+                ++i;
+                ++j;
+            }
+        }
+
+        PackedSortedVector a(dense);
+        PackedSortedVector b(sparse);
+        CHECK(intersect(a, b) == expected);
+        CHECK(intersect(b, a) == expected);
+        CHECK(intersect(a, PackedSortedVector()).empty());
+    }
+}
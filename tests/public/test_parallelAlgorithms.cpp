@@ -0,0 +1,62 @@
+#include <ics_parallel_algorithms.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace {
+    Vector<int64_t> iota(size_t n) {
+        Vector<int64_t> values;
+        for (size_t i = 0; i < n; ++i) values.push_back(static_cast<int64_t>(i));
+        return values;
+    }
+
+    TEST_CASE("Parallel algorithms match their serial results", "[parallel-algorithms]") {
+        ThreadPool pool(4);
+        for (size_t grain : {size_t{0}, size_t{1}, size_t{1000}}) {
+            ParallelOptions options{grain, &pool};
+            for (size_t n : {size_t{0}, size_t{1}, size_t{17}, size_t{100003}}) {
+                Vector<int64_t> values = iota(n);
+                parallel_for_each(values, [](int64_t& value) { value *= 3; }, options);
+                CHECK(parallel_reduce(values, 0, [](int64_t a, int64_t b) { return a + b; }, options) ==
+                      static_cast<int64_t>(3 * n * (n > 0 ? n - 1 : 0) / 2));
+                CHECK(parallel_count_if(values, [](int64_t value) { return value % 2 == 0; }, options) == (n + 1) / 2);
+
+                Vector<double> halves = parallel_transform(values, [](int64_t value) { return value / 2.0; }, options);
+                REQUIRE(halves.size() == n);
+                if (n > 0) CHECK(halves[n - 1] == static_cast<double>(n - 1) * 1.5);
+
+                Vector<int64_t> copy = parallel_copy(values, options);
+                CHECK(copy == values);
+                parallel_fill(copy, -1, options);
+                CHECK(parallel_count_if(copy, [](int64_t value) { return value == -1; }, options) == n);
+            }
+        }
+    }
+
+    TEST_CASE("Parallel algorithms handle non-trivial types and raw ranges", "[parallel-algorithms]") {
+        ThreadPool pool(3);
+        ParallelOptions options{64, &pool};
+        Vector<std::string> words;
+        for (int i = 0; i < 5000; ++i) words.push_back(std::to_string(i));
+
+        // order-sensitive op: chunks are combined left to right
+        std::string joined = parallel_reduce(words, std::string(), [](std::string a, const std::string& b) { return a + b; },
+                                             options);
+        std::string expected;
+        for (const std::string& word : words) expected += word;
+        CHECK(joined == expected);
+
+        Vector<size_t> lengths = parallel_transform(words, [](const std::string& word) { return word.size(); }, options);
+        CHECK(lengths[4999] == 4);
+        Vector<std::string> copy = parallel_copy(words, options);
+        CHECK(copy == words);
+
+        int raw[1000];
+        parallel_fill(raw, 1000, 7, options);
+        CHECK(parallel_reduce(raw, 1000, 0, [](int a, int b) { return a + b; }, options) == 7000);
+        CHECK_THROWS_AS(parallel_for_each(words, [](std::string& word) { if (word == "4321") throw VectorException("x"); },
+                                          options),
+                        VectorException);
+    }
+}
@@ -0,0 +1,111 @@
+#include <ics_parallel_scan.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace {
+    template <typename T>
+    Vector<T> pattern(size_t n) {
+        Vector<T> values;
+        for (size_t i = 0; i < n; ++i) values.push_back(static_cast<T>((i * 7919) % 201) - static_cast<T>(100));
+        return values;
+    }
+
+    template <typename T>
+    void check_sums(ThreadPool& pool) {
+        for (size_t grain : {size_t{0}, size_t{1}, size_t{333}}) {
+            ParallelOptions options{grain, &pool};
+            for (size_t n : {size_t{0}, size_t{1}, size_t{3}, size_t{17}, size_t{100003}}) {
+                Vector<T> values = pattern<T>(n);
+                Vector<T> inclusive = parallel_inclusive_scan(values, std::plus<>(), options);
+                Vector<T> exclusive = parallel_exclusive_scan(values, 5, std::plus<>(), options);
+                REQUIRE(inclusive.size() == n);
+                REQUIRE(exclusive.size() == n);
+                T running = 0;
+                bool matches = true;
+                for (size_t i = 0; i < n; ++i) {
+                    matches = matches && exclusive[i] == running + 5;
+                    running += values[i];
+                    matches = matches && inclusive[i] == running;
+                }
+                CHECK(matches);
+            }
+        }
+    }
+
+    TEST_CASE("Parallel scans match serial prefix sums", "[parallel-scan]") {
+        ThreadPool pool(4);
+        check_sums<int32_t>(pool);
+        check_sums<uint32_t>(pool);
+        check_sums<int64_t>(pool);
+        check_sums<double>(pool);
+    }
+
+    TEST_CASE("Parallel scans take other operations and run in place", "[parallel-scan]") {
+        ThreadPool pool(3);
+        ParallelOptions options{64, &pool};
+        Vector<int32_t> values = pattern<int32_t>(5000);
+        auto max = [](int32_t a, int32_t b) { return std::max(a, b); };
+        Vector<int32_t> peaks = parallel_inclusive_scan(values, max, options);
+        int32_t peak = values[0];
+        for (size_t i = 0; i < values.size(); ++i) {
+            peak = std::max(peak, values[i]);
+            CHECK(peaks[i] == peak);
+        }
+
+        // order-sensitive op: every chunk continues from the ones before it
+        Vector<std::string> words;
+        for (int i = 0; i < 300; ++i) words.push_back(std::to_string(i));
+        Vector<std::string> joined = parallel_exclusive_scan(words, std::string(">"), std::plus<>(), ParallelOptions{8, &pool});
+        CHECK(joined[0] == ">");
+        CHECK(joined[12] == ">01234567891011");
+
+        Vector<int64_t> counts;
+        for (int i = 0; i < 1000; ++i) counts.push_back(1);
+        parallel_inclusive_scan(&counts[0], counts.size(), &counts[0], std::plus<>(), options);
+        CHECK(counts[999] == 1000);
+        parallel_exclusive_scan(&counts[0], counts.size(), &counts[0], 0, std::plus<>(), options);
+        CHECK(counts[0] == 0);
+        CHECK(counts[999] == 999 * 1000 / 2);
+    }
+
+    TEST_CASE("Parallel copy_if and partition keep the original order", "[parallel-scan]") {
+        ThreadPool pool(4);
+        for (size_t grain : {size_t{0}, size_t{1}, size_t{100}}) {
+            ParallelOptions options{grain, &pool};
+            for (size_t n : {size_t{0}, size_t{1}, size_t{50}, size_t{100003}}) {
+                Vector<int64_t> values;
+                for (size_t i = 0; i < n; ++i) values.push_back(static_cast<int64_t>(i));
+                auto odd_third = [](int64_t value) { return value % 3 == 1; };
+
+                Vector<int64_t> picked = parallel_copy_if(values, odd_third, options);
+                REQUIRE(picked.size() == (n + 1) / 3);
+                bool ordered = true;
+                for (size_t i = 0; i < picked.size(); ++i) ordered = ordered && picked[i] == static_cast<int64_t>(3 * i + 1);
+                CHECK(ordered);
+
+                size_t selected = parallel_partition(values, odd_third, options);
+                REQUIRE(selected == picked.size());
+                REQUIRE(values.size() == n);
+                bool stable = true;
+                for (size_t i = 0; i < selected; ++i) stable = stable && values[i] == picked[i];
+                for (size_t i = selected + 1; i < n; ++i) stable = stable && values[i - 1] < values[i] && !odd_third(values[i]);
+                CHECK(stable);
+            }
+        }
+    }
+
+    TEST_CASE("Parallel partition moves non-trivial elements", "[parallel-scan]") {
+        ThreadPool pool(2);
+        Vector<std::string> words;
+        for (int i = 0; i < 2000; ++i) words.push_back(std::to_string(i));
+        auto short_word = [](const std::string& word) { return word.size() < 3; };
+        CHECK(parallel_copy_if(words, short_word, ParallelOptions{16, &pool}).size() == 100);
+        CHECK(parallel_partition(words, short_word, ParallelOptions{16, &pool}) == 100);
+        CHECK(words[99] == "99");
+        CHECK(words[100] == "100");
+        CHECK(words[1999] == "1999");
+    }
+}
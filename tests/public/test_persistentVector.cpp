@@ -0,0 +1,122 @@
+#include <ics_persistent_vector.hpp>
+#include <ics_mapped_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <sys/wait.h>
+
+namespace {
+    std::string temp_path(const std::string& name) {
+        std::string path = (std::filesystem::temp_directory_path() / ("ics_persistent_vector_" + name)).string();
+        std::remove(path.c_str());
+        return path;
+    }
+
+    struct Tick {
+        int64_t time;
+        double price;
+
+        bool operator==(const Tick&) const = default;
+    };
+
+    TEST_CASE("PersistentVector keeps its elements across reopen", "[persistent-vector]") {
+        std::string path = temp_path("reopen.bin");
+        Vector<int32_t> expected;
+        {
+            PersistentVector<int32_t> log(path);
+            CHECK(log.empty());
+            CHECK(log.capacity() > 0);
+            for (int32_t i = 0; i < 100000; ++i) {
+                log.push_back(i * 7);
+                expected.push_back(i * 7);
+            }
+            CHECK(log.size() == 100000);
+            CHECK(log.capacity() >= log.size());
+            CHECK(log == expected);
+            log[5] = -1;
+            expected[5] = -1;
+        }
+
+        PersistentVector<int32_t> log(path);
+        CHECK(log.size() == 100000);
+        CHECK(log == expected);
+        CHECK(log.at(99999) == 99999 * 7);
+        CHECK_THROWS_AS(log.at(100000), VectorException);
+
+        log.pop_back();
+        expected.pop_back();
+        CHECK(log.back() == expected.back());
+        CHECK(log.to_vector() == expected);
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("PersistentVector files are binary vector files", "[persistent-vector]") {
+        std::string path = temp_path("format.bin");
+        Vector<Tick> ticks;
+        for (int i = 0; i < 1000; ++i) ticks.push_back(Tick{i, 100.0 + i});
+
+        {
+            PersistentVector<Tick> log(path, 10);
+            log.append(ticks.data(), ticks.size());
+            log.flush();
+            CHECK(std::filesystem::file_size(path) >= sizeof(BinaryHeader) + 1000 * sizeof(Tick));
+            CHECK((map_binary<Tick>(path) == ticks));
+            CHECK((log.to_vector() == ticks));
+        }
+
+        save_binary(ticks, path);
+        PersistentVector<Tick> reopened(path);
+        CHECK(reopened.size() == ticks.size());
+        reopened.push_back(Tick{-1, 0.0});
+        CHECK(reopened.back().time == -1);
+
+        CHECK_THROWS_WITH(PersistentVector<int>(path), Catch::Matchers::ContainsSubstring("type mismatch"));
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("PersistentVector publishes its size on flush", "[persistent-vector]") {
+        std::string path = temp_path("flush.bin");
+        pid_t child = ::fork();
+        REQUIRE(child >= 0);
+        if (child == 0) {
+            // exits without running destructors, like a crash
+            PersistentVector<uint64_t> log(path);
+            for (uint64_t i = 0; i < 10; ++i) log.push_back(i);
+            log.flush();
+            for (uint64_t i = 0; i < 5000; ++i) log.push_back(i);
+            ::_exit(0);
+        }
+        int status = 0;
+        REQUIRE(::waitpid(child, &status, 0) == child);
+
+        PersistentVector<uint64_t> log(path);
+        REQUIRE(log.size() == 10);
+        CHECK(log[9] == 9);
+
+        PersistentVector<uint64_t> moved = std::move(log);
+        CHECK(moved.size() == 10);
+        moved.clear();
+        moved.reserve(1 << 20);
+        CHECK(moved.capacity() >= size_t{1} << 20);
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("PersistentVector grows from a file with no room for an element", "[persistent-vector]") {
+        struct Page {
+            char bytes[8192];
+        };
+        std::string path = temp_path("empty_pages.bin");
+        save_binary(Vector<Page>(), path);
+        PersistentVector<Page> log(path);
+        CHECK(log.capacity() == 0);
+        Page page{};
+        page.bytes[8191] = 'x';
+        log.push_back(page);
+        log.push_back(page);
+        CHECK(log.size() == 2);
+        CHECK(log[1].bytes[8191] == 'x');
+        std::remove(path.c_str());
+    }
+}
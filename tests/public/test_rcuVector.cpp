@@ -0,0 +1,113 @@
+#include <ics_rcu_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+    TEST_CASE("RcuVector readers keep their version", "[rcu-vector]") {
+        Vector<std::string> initial;
+        initial.push_back("a");
+        RcuVector<std::string> rcu(initial);
+        CHECK(rcu.read().size() == 1);
+
+        {
+            RcuVector<std::string>::ReadGuard guard = rcu.read();
+            rcu.update([](Vector<std::string>& values) { values.push_back("b"); });
+            CHECK(guard.size() == 1);
+            CHECK(guard[0] == "a");
+            CHECK(rcu.retired() == 1);
+
+            RcuVector<std::string>::ReadGuard nested = rcu.read();
+            CHECK(nested.size() == 2);
+            CHECK(nested->at(1) == "b");
+        }
+        rcu.store(Vector<std::string>());
+        CHECK(rcu.retired() == 0);
+        CHECK(rcu.load().empty());
+
+        CHECK_THROWS_AS(rcu.update([](Vector<std::string>& values) { values.pop_back(); }), VectorException);
+        CHECK(rcu.load().empty());
+    }
+
+    TEST_CASE("RcuVector reclaims versions once readers leave", "[rcu-vector]") {
+        RcuVector<int> rcu;
+        std::atomic<bool> pinned{false};
+        std::atomic<bool> release{false};
+        std::thread reader([&] {
+            RcuVector<int>::ReadGuard guard = rcu.read();
+            pinned.store(true);
+            while (!release.load()) std::this_thread::yield();
+        });
+        while (!pinned.load()) std::this_thread::yield();
+
+        for (int i = 0; i < 5; ++i) rcu.update([i](Vector<int>& values) { values.push_back(i); });
+        CHECK(rcu.retired() == 5);
+        release.store(true);
+        reader.join();
+        rcu.synchronize();
+        CHECK(rcu.retired() == 0);
+        CHECK(rcu.read()[4] == 4);
+    }
+
+    TEST_CASE("RcuVector readers never see a half-made version", "[rcu-vector]") {
+        Vector<long> zeros;
+        for (int i = 0; i < 256; ++i) zeros.push_back(0);
+        RcuVector<long> rcu(zeros);
+        std::atomic<bool> done{false};
+        std::atomic<int> torn{0};
+        Vector<std::thread> readers;
+        for (int t = 0; t < 3; ++t) {
+            readers.push_back(std::thread([&] {
+                while (!done.load()) {
+                    RcuVector<long>::ReadGuard guard = rcu.read();
+                    for (long value : *guard) {
+                        if (value != guard[0]) torn.fetch_add(1);
+                    }
+                }
+            }));
+        }
+        for (long round = 1; round <= 500; ++round) {
+            rcu.update([round](Vector<long>& values) {
+                for (size_t i = 0; i < values.size(); ++i) values[i] = round;
+            });
+        }
+        done.store(true);
+        for (std::thread& thread : readers) thread.join();
+        rcu.synchronize();
+        CHECK(torn.load() == 0);
+        CHECK(rcu.read()[255] == 500);
+    }
+
+    TEST_CASE("RcuVector reads alternate between vectors sharing a cache way", "[rcu-vector]") {
+        // registry ids are handed out in order, so the first and last of
+        // nine vectors land in the same way of the per-thread cache
+        Vector<std::unique_ptr<RcuVector<int>>> rcus;
+        for (int i = 0; i < 9; ++i) {
+            Vector<int> values;
+            values.push_back(i);
+            rcus.push_back(std::make_unique<RcuVector<int>>(values));
+        }
+        RcuVector<int>& first = *rcus[0];
+        RcuVector<int>& last = *rcus[8];
+        const int* first_data = first.read()->data();
+        bool stable = true;
+        for (int i = 0; i < 10000; ++i) {
+            stable = stable && first.read()[0] == 0 && last.read()[0] == 8 && first.read()->data() == first_data;
+        }
+        CHECK(stable);
+
+        ics_detail::ThreadRegistry<int> registries[9];
+        int* first_slot = &registries[0].local();
+        int* last_slot = &registries[8].local();
+        for (int i = 0; i < 1000; ++i) {
+            REQUIRE(&registries[0].local() == first_slot);
+            REQUIRE(&registries[8].local() == last_slot);
+        }
+        std::thread([&] { registries[0].local() = 1; }).join();
+        CHECK(registries[0].size() == 2);
+        CHECK(&registries[0].local() == first_slot);
+    }
+}
@@ -0,0 +1,78 @@
+#include <ics_rle_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+namespace {
+    TEST_CASE("RleVector merges consecutive equal values", "[rle-vector]") {
+        RleVector<int> rle;
+        for (int v : {1, 1, 1, 2, 2, 3, 1, 1}) rle.push_back(v);
+
+        CHECK(rle.size() == 8);
+        CHECK(rle.run_count() == 4);
+        CHECK(rle.run(1).value == 2);
+        CHECK(rle.run(1).start == 3);
+        CHECK(rle.run(1).length == 2);
+        CHECK(rle.front() == 1);
+        CHECK(rle.back() == 1);
+    }
+
+    TEST_CASE("RleVector random access finds the right run", "[rle-vector]") {
+        RleVector<int> rle;
+        rle.append(7, 100);
+        rle.append(8, 1);
+        rle.append(9, 50);
+
+        CHECK(rle[0] == 7);
+        CHECK(rle[99] == 7);
+        CHECK(rle[100] == 8);
+        CHECK(rle[101] == 9);
+        CHECK(rle.at(150) == 9);
+        CHECK_THROWS_AS(rle.at(151), VectorException);
+        CHECK(rle.run_index(100) == 1);
+    }
+
+    TEST_CASE("RleVector aggregates per run", "[rle-vector]") {
+        RleVector<long> rle;
+        rle.append(3, 1000000);
+        rle.append(-1, 10);
+        rle.append(3, 5);
+
+        CHECK(rle.sum() == 3000015 - 10);
+        CHECK(rle.count(3) == 1000005);
+        CHECK(rle.min() == -1);
+        CHECK(rle.max() == 3);
+
+        size_t runs_seen = 0;
+        rle.for_each_run([&runs_seen](long, size_t) { ++runs_seen; });
+        CHECK(runs_seen == 3);
+
+        RleVector<long> empty;
+        CHECK_THROWS_AS(empty.min(), VectorException);
+    }
+
+    TEST_CASE("RleVector converts to and from Vector", "[rle-vector]") {
+        Vector<int> values;
+        for (int v : {4, 4, 5, 6, 6, 6}) values.push_back(v);
+
+        RleVector<int> rle(values);
+        CHECK(rle.run_count() == 3);
+        CHECK(rle.to_vector() == values);
+
+        Vector<int> walked;
+        for (int v : rle) walked.push_back(v);
+        CHECK(walked == values);
+    }
+
+    TEST_CASE("RleVector pop_back shrinks the last run", "[rle-vector]") {
+        RleVector<int> rle;
+        for (int v : {1, 2, 2}) rle.push_back(v);
+
+        rle.pop_back();
+        CHECK(rle.run_count() == 2);
+        rle.pop_back();
+        CHECK(rle.run_count() == 1);
+        CHECK(rle[0] == 1);
+        rle.pop_back();
+        CHECK(rle.empty());
+        CHECK_THROWS_AS(rle.pop_back(), VectorException);
+    }
+}
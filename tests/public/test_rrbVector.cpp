@@ -0,0 +1,124 @@
+#include <ics_rrb_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <random>
+#include <string>
+
+namespace {
+    TEST_CASE("RrbVector versions are independent", "[rrb-vector]") {
+        RrbVector<int> empty;
+        CHECK(empty.empty());
+        RrbVector<int> v = empty;
+        Vector<int> expected;
+        for (int i = 0; i < 40000; ++i) {
+            v = v.push_back(i);
+            expected.push_back(i);
+        }
+        CHECK(v.size() == 40000);
+        CHECK(empty.empty());
+        CHECK(v == expected);
+        CHECK(v.front() == 0);
+        CHECK(v.back() == 39999);
+        CHECK(v.at(33000) == 33000);
+        CHECK_THROWS_AS(v.at(40000), VectorException);
+        CHECK_THROWS_AS(v.set(40000, 1), VectorException);
+
+        RrbVector<int> changed = v.set(5, -5).set(39999, -1).set(32768, -2);
+        CHECK(v[5] == 5);
+        CHECK(v[39999] == 39999);
+        CHECK(changed[5] == -5);
+        CHECK(changed[39999] == -1);
+        CHECK(changed[32768] == -2);
+        CHECK(changed.size() == v.size());
+
+        RrbVector<int> shorter = v.pop_back();
+        CHECK(shorter.size() == 39999);
+        CHECK(v.size() == 40000);
+        CHECK_THROWS_AS(empty.pop_back(), VectorException);
+        CHECK(RrbVector<int>(expected) == v);
+        CHECK(v.to_vector() == expected);
+    }
+
+    TEST_CASE("RrbVector slices and keeps growing", "[rrb-vector]") {
+        Vector<std::string> values;
+        for (int i = 0; i < 5000; ++i) values.push_back(std::to_string(i));
+        RrbVector<std::string> v(values);
+
+        RrbVector<std::string> middle = v.slice(1000, 4000);
+        CHECK(middle.size() == 3000);
+        CHECK(middle[0] == "1000");
+        CHECK(middle[2999] == "3999");
+        CHECK_THROWS_AS(v.slice(10, 5), VectorException);
+        CHECK_THROWS_AS(v.slice(0, 5001), VectorException);
+        CHECK(v.slice(7, 7).empty());
+        CHECK(v.drop(4990).size() == 10);
+        CHECK(v.take(3)[2] == "2");
+
+        // a relaxed prefix must not break indexing as the vector grows again
+        RrbVector<std::string> odd = v.drop(17);
+        for (int i = 5000; i < 60000; ++i) odd = odd.push_back(std::to_string(i));
+        REQUIRE(odd.size() == 59983);
+        bool matches = true;
+        size_t i = 17;
+        for (const std::string& value : odd) matches = matches && value == std::to_string(i++);
+        CHECK(matches);
+        CHECK(odd[40000] == "40017");
+        CHECK(odd.set(20000, "x")[20000] == "x");
+        CHECK(v[17] == "17");
+    }
+
+    TEST_CASE("RrbVector matches a Vector under random edits", "[rrb-vector]") {
+        std::mt19937 rng(66);
+        RrbVector<int> v;
+        Vector<int> model;
+        for (int step = 0; step < 3000; ++step) {
+            unsigned op = rng() % 10;
+            if (op < 6) {
+                int count = static_cast<int>(rng() % 200);
+                for (int k = 0; k < count; ++k) {
+                    int value = static_cast<int>(rng());
+                    v = v.push_back(value);
+                    model.push_back(value);
+                }
+            } else if (op < 8 && !model.empty()) {
+                size_t index = rng() % model.size();
+                int value = static_cast<int>(rng());
+                v = v.set(index, value);
+                model[index] = value;
+            } else if (!model.empty()) {
+                size_t first = rng() % (model.size() + 1);
+                size_t last = first + rng() % (model.size() - first + 1);
+                v = v.slice(first, last);
+                Vector<int> kept;
+                for (size_t k = first; k < last; ++k) kept.push_back(model[k]);
+                model = kept;
+            }
+            if (!(v == model)) {
+                FAIL("diverged at step " << step);
+            }
+        }
+        CHECK(v.size() == model.size());
+    }
+
+    TEST_CASE("RrbVector transients edit in place until frozen", "[rrb-vector]") {
+        RrbVector<int> base = RrbVector<int>().push_back(1).push_back(2);
+        RrbVector<int>::Transient builder = base.transient();
+        for (int i = 3; i <= 10000; ++i) builder.push_back(i);
+        builder.set(0, -1);
+        CHECK(builder.size() == 10000);
+        CHECK(builder[9999] == 10000);
+        CHECK(base.size() == 2);
+        CHECK(base[0] == 1);
+
+        RrbVector<int> frozen = builder.persistent();
+        builder.set(5000, 0);
+        builder.push_back(10001);
+        CHECK(frozen.size() == 10000);
+        CHECK(frozen[5000] == 5001);
+        CHECK(frozen[0] == -1);
+
+        RrbVector<int> after = builder.persistent();
+        CHECK(after[5000] == 0);
+        CHECK(after.back() == 10001);
+    }
+}
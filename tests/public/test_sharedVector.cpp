@@ -0,0 +1,114 @@
+#include <ics_shared_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+    using namespace std::chrono_literals;
+
+    std::string segment_name(const std::string& name) {
+        std::string full = "/ics_shared_vector_" + name + "_" + std::to_string(::getpid());
+        SharedVector<int>::remove(full);
+        return full;
+    }
+
+    TEST_CASE("SharedVectorReader sees what the writer published", "[shared-vector]") {
+        std::string name = segment_name("basic");
+        SharedVector<int64_t> writer(name, 4);
+        CHECK(writer.empty());
+        CHECK_THROWS_WITH(SharedVector<int64_t>(name), Catch::Matchers::ContainsSubstring("cannot open"));
+
+        SharedVectorReader<int64_t> reader(name);
+        CHECK(writer.readers() == 1);
+        CHECK(reader.empty());
+
+        for (int64_t i = 0; i < 10; ++i) writer.push_back(i * i);
+        CHECK(reader.size() == 0);
+        CHECK(reader.refresh() == 10);
+        CHECK(reader[9] == 81);
+        CHECK(reader.at(3) == 9);
+        CHECK_THROWS_AS(reader.at(10), VectorException);
+
+        // growth remaps the reader on refresh
+        Vector<int64_t> more;
+        for (int64_t i = 0; i < 100000; ++i) more.push_back(-i);
+        writer.append(more.data(), more.size());
+        CHECK(writer.capacity() >= 100010);
+        CHECK(reader.refresh() == 100010);
+        CHECK(reader[100009] == -99999);
+        CHECK(reader.to_vector()[4] == 16);
+
+        CHECK_FALSE(reader.sealed());
+        CHECK_FALSE(reader.wait_sealed(1ms));
+        writer.seal();
+        CHECK(reader.wait_sealed(1ms));
+        SharedVector<int64_t>::remove(name);
+    }
+
+    TEST_CASE("SharedVectorReader validates the segment", "[shared-vector]") {
+        std::string name = segment_name("types");
+        CHECK_THROWS_WITH(SharedVectorReader<int>(name), Catch::Matchers::ContainsSubstring("not available"));
+
+        SharedVector<int> writer(name);
+        CHECK_THROWS_WITH(SharedVectorReader<float>(name), Catch::Matchers::ContainsSubstring("type mismatch"));
+        SharedVector<int>::remove(name);
+    }
+
+    TEST_CASE("SharedVector crosses a process boundary", "[shared-vector]") {
+        std::string name = segment_name("fork");
+        pid_t child = ::fork();
+        REQUIRE(child >= 0);
+        if (child == 0) {
+            // reader: attach once the parent has created the segment
+            int status = 1;
+            try {
+                SharedVectorReader<uint32_t> reader(name, 5000ms);
+                if (reader.wait_sealed(5000ms) && reader.size() == 200000) {
+                    status = 0;
+                    for (size_t i = 0; i < reader.size(); ++i) {
+                        if (reader[i] != i * 3) status = 2;
+                    }
+                }
+            } catch (...) {
+                status = 3;
+            }
+            ::_exit(status);
+        }
+
+        SharedVector<uint32_t> writer(name, 16);
+        CHECK(writer.wait_for_readers(1, 5000ms));
+        for (uint32_t i = 0; i < 200000; ++i) writer.push_back(i * 3);
+        writer.seal();
+
+        int status = -1;
+        REQUIRE(::waitpid(child, &status, 0) == child);
+        CHECK(WIFEXITED(status));
+        CHECK(WEXITSTATUS(status) == 0);
+        SharedVector<uint32_t>::remove(name);
+    }
+
+    TEST_CASE("SharedVectorReader keeps up with a growing writer", "[shared-vector]") {
+        std::string name = segment_name("threads");
+        SharedVector<uint64_t> writer(name, 1);
+        SharedVectorReader<uint64_t> reader(name);
+
+        std::thread producer([&] {
+            for (uint64_t i = 0; i < 50000; ++i) writer.push_back(i + 1);
+            writer.seal();
+        });
+        bool consistent = true;
+        while (!reader.sealed()) {
+            size_t n = reader.refresh();
+            if (n > 0 && reader[n - 1] != n) consistent = false;
+        }
+        producer.join();
+        reader.refresh();
+        CHECK(consistent);
+        CHECK(reader.size() == 50000);
+        CHECK(reader[49999] == 50000);
+        SharedVector<uint64_t>::remove(name);
+    }
+}
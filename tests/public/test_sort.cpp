@@ -0,0 +1,163 @@
+#include <ics_sort.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Item {
+        int32_t key;
+        uint32_t order;
+    };
+
+    template <typename T>
+    Vector<T> to_vector(const std::vector<T>& values) {
+        Vector<T> result;
+        for (const T& value : values) result.push_back(value);
+        return result;
+    }
+
+    template <typename T, typename Compare = std::less<>>
+    bool matches_std_sort(const Vector<T>& sorted, std::vector<T> expected, Compare comp = {}) {
+        std::sort(expected.begin(), expected.end(), comp);
+        if (sorted.size() != expected.size()) return false;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            if (comp(sorted[i], expected[i]) || comp(expected[i], sorted[i])) return false;
+        }
+        return true;
+    }
+
+    // random, sorted, reversed and few-unique inputs of n elements
+    std::vector<std::vector<int64_t>> distributions(size_t n) {
+        std::mt19937_64 rng(n);
+        std::vector<std::vector<int64_t>> inputs(4);
+        for (size_t i = 0; i < n; ++i) {
+            inputs[0].push_back(static_cast<int64_t>(rng()));
+            inputs[1].push_back(static_cast<int64_t>(i) - 1000);
+            inputs[2].push_back(static_cast<int64_t>(n - i));
+            inputs[3].push_back(static_cast<int64_t>(rng() % 4) - 2);
+        }
+        return inputs;
+    }
+
+    TEST_CASE("Sorts match std::sort on every distribution", "[sort]") {
+        ThreadPool serial(1);
+        ThreadPool pool(4);
+        auto by_value = [](int64_t a, int64_t b) { return a < b; };
+        for (ThreadPool* used : {&serial, &pool}) {
+            for (size_t grain : {size_t{0}, size_t{1}, size_t{100}}) {
+                ParallelOptions options{grain, used};
+                for (size_t n : {size_t{0}, size_t{1}, size_t{2}, size_t{5}, size_t{30}, size_t{300}, size_t{20011}}) {
+                    for (const std::vector<int64_t>& input : distributions(n)) {
+                        Vector<int64_t> radix = to_vector(input);
+                        sort(radix, std::less<>(), options);
+                        CHECK(matches_std_sort(radix, input));
+
+                        Vector<int64_t> quick = to_vector(input);
+                        sort(quick, by_value, options);
+                        CHECK(matches_std_sort(quick, input));
+
+                        Vector<int64_t> merged = to_vector(input);
+                        stable_sort(merged, by_value, options);
+                        CHECK(matches_std_sort(merged, input));
+
+                        Vector<int64_t> descending = to_vector(input);
+                        sort(descending, std::greater<>(), options);
+                        CHECK(matches_std_sort(descending, input, std::greater<>()));
+                    }
+                }
+            }
+        }
+    }
+
+    TEST_CASE("Radix sort orders signed, unsigned and floating-point keys", "[sort]") {
+        ThreadPool pool(3);
+        ParallelOptions options{64, &pool};
+        std::mt19937 rng(7);
+        std::vector<int8_t> bytes;
+        std::vector<uint32_t> words;
+        std::vector<double> reals;
+        std::vector<float> floats;
+        for (int i = 0; i < 5000; ++i) {
+            bytes.push_back(static_cast<int8_t>(rng()));
+            words.push_back(static_cast<uint32_t>(rng()) >> (i % 20));
+            reals.push_back((static_cast<double>(rng()) - 2e9) / 3.0);
+            floats.push_back(static_cast<float>(static_cast<int32_t>(rng() % 2001) - 1000) * 0.25f);
+        }
+        reals[10] = -INFINITY;
+        reals[20] = INFINITY;
+
+        Vector<int8_t> sorted_bytes = to_vector(bytes);
+        sort(sorted_bytes, std::less<>(), options);
+        CHECK(matches_std_sort(sorted_bytes, bytes));
+        Vector<uint32_t> sorted_words = to_vector(words);
+        stable_sort(sorted_words);
+        CHECK(matches_std_sort(sorted_words, words));
+        Vector<double> sorted_reals = to_vector(reals);
+        sort(sorted_reals, std::less<double>(), options);
+        CHECK(matches_std_sort(sorted_reals, reals));
+        CHECK(sorted_reals[0] == -INFINITY);
+        Vector<float> sorted_floats = to_vector(floats);
+        sort(sorted_floats);
+        CHECK(matches_std_sort(sorted_floats, floats));
+    }
+
+    TEST_CASE("Stable sorts keep equal elements in order", "[sort]") {
+        ThreadPool pool(4);
+        for (size_t n : {size_t{5}, size_t{40}, size_t{1000}, size_t{30011}}) {
+            std::mt19937 rng(static_cast<uint32_t>(n));
+            Vector<Item> items;
+            for (size_t i = 0; i < n; ++i) items.push_back(Item{static_cast<int32_t>(rng() % 50) - 25, static_cast<uint32_t>(i)});
+            auto in_order = [](const Vector<Item>& sorted) {
+                for (size_t i = 1; i < sorted.size(); ++i) {
+                    const Item& a = sorted[i - 1];
+                    const Item& b = sorted[i];
+                    if (a.key > b.key || (a.key == b.key && a.order > b.order)) return false;
+                }
+                return true;
+            };
+            for (size_t grain : {size_t{0}, size_t{1}, size_t{64}}) {
+                ParallelOptions options{grain, &pool};
+                Vector<Item> by_key = items;
+                sort_by_key(by_key, [](const Item& item) { return item.key; }, options);
+                CHECK(in_order(by_key));
+
+                Vector<Item> by_float = items;
+                sort_by_key(by_float, [](const Item& item) { return static_cast<float>(item.key) / 4; }, options);
+                CHECK(in_order(by_float));
+
+                Vector<Item> merged = items;
+                stable_sort(merged, [](const Item& a, const Item& b) { return a.key < b.key; }, options);
+                CHECK(in_order(merged));
+            }
+        }
+    }
+
+    TEST_CASE("Sorts handle non-trivial elements and keys", "[sort]") {
+        ThreadPool pool(2);
+        ParallelOptions options{16, &pool};
+        std::vector<std::string> words;
+        for (int i = 0; i < 3000; ++i) words.push_back(std::to_string((i * 7919) % 3000));
+
+        Vector<std::string> quick = to_vector(words);
+        sort(quick, std::less<>(), options);
+        CHECK(matches_std_sort(quick, words));
+
+        Vector<std::string> by_length = to_vector(words);
+        sort_by_key(by_length, [](const std::string& word) { return word.size(); }, options);
+        CHECK(by_length[0] == "0");
+        CHECK(by_length[9].size() == 1);
+        CHECK(by_length[10].size() == 2);
+
+        // non-arithmetic key: compared with <, still stable
+        Vector<std::string> by_last = to_vector(words);
+        sort_by_key(by_last, [](const std::string& word) { return std::string(1, word.back()); }, options);
+        for (size_t i = 1; i < by_last.size(); ++i) REQUIRE(by_last[i - 1].back() <= by_last[i].back());
+        CHECK(by_last[0] == "0");
+        CHECK(by_last[1] == "1190");
+    }
+}
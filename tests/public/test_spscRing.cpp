@@ -0,0 +1,81 @@
+#include <ics_spsc_ring.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace {
+    TEST_CASE("SpscRing is a bounded FIFO", "[spsc-ring]") {
+        SpscRing<std::string> ring(3);
+        CHECK(ring.capacity() == 4);
+        CHECK(ring.empty());
+        std::string out;
+        CHECK_FALSE(ring.try_pop(out));
+
+        for (int round = 0; round < 3; ++round) {
+            for (int i = 0; i < 4; ++i) CHECK(ring.try_push(std::to_string(i)));
+            CHECK_FALSE(ring.try_push("full"));
+            CHECK(ring.size() == 4);
+            for (int i = 0; i < 4; ++i) {
+                REQUIRE(ring.try_pop(out));
+                CHECK(out == std::to_string(i));
+            }
+        }
+
+        Vector<std::string> batch;
+        for (int i = 0; i < 6; ++i) batch.push_back("b" + std::to_string(i));
+        CHECK(ring.push_n(std::span<std::string>(&batch[0], batch.size())) == 4);
+        Vector<std::string> got;
+        for (int i = 0; i < 3; ++i) got.push_back("");
+        CHECK(ring.pop_n(std::span<std::string>(&got[0], got.size())) == 3);
+        CHECK(got[2] == "b2");
+        CHECK(ring.pop_n(std::span<std::string>(&got[0], got.size())) == 1);
+        CHECK(got[0] == "b3");
+    }
+
+    TEST_CASE("SpscRing wraps batches around the end", "[spsc-ring]") {
+        SpscRing<int> ring(8);
+        int in[5] = {1, 2, 3, 4, 5};
+        int out[8] = {};
+        for (int round = 0; round < 10; ++round) {
+            CHECK(ring.push_n(in) == 5);
+            CHECK(ring.pop_n(std::span<int>(out, 5)) == 5);
+            CHECK(out[0] == 1);
+            CHECK(out[4] == 5);
+        }
+        CHECK(ring.push_n(in) == 5);
+        CHECK(ring.push_n(in) == 3);
+        CHECK(ring.pop_n(out) == 8);
+        CHECK(out[5] == 1);
+        CHECK(out[7] == 3);
+    }
+
+    TEST_CASE("SpscRing hands values between two threads in order", "[spsc-ring]") {
+        constexpr uint64_t count = 1000000;
+        SpscRing<uint64_t> ring(1024);
+        std::thread producer([&] {
+            uint64_t batch[100];
+            uint64_t next = 0;
+            while (next < count) {
+                if (next % 3 == 0) {
+                    if (ring.try_push(next)) ++next;
+                    continue;
+                }
+                size_t n = 0;
+                for (; n < 100 && next + n < count; ++n) batch[n] = next + n;
+                next += ring.push_n(std::span<uint64_t>(batch, n));
+            }
+        });
+        uint64_t expected = 0;
+        bool in_order = true;
+        uint64_t batch[64];
+        while (expected < count) {
+            size_t n = ring.pop_n(batch);
+            for (size_t i = 0; i < n; ++i) in_order = in_order && batch[i] == expected++;
+        }
+        producer.join();
+        CHECK(in_order);
+        CHECK(ring.empty());
+    }
+}
@@ -0,0 +1,114 @@
+#include <ics_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace {
+    // operator<< output as produced element by element through the stream.
+    template <typename T>
+    std::string stream_reference(const Vector<T>& vec, std::ios_base& (*manip)(std::ios_base&) = nullptr,
+                                 int precision = 6) {
+        std::ostringstream os;
+        os.precision(precision);
+        if (manip) os << manip;
+        for (const T& value : vec) os << value << " ";
+        return os.str();
+    }
+
+    template <typename T>
+    std::string fast(const Vector<T>& vec, std::ios_base& (*manip)(std::ios_base&) = nullptr, int precision = 6) {
+        std::ostringstream os;
+        os.precision(precision);
+        if (manip) os << manip;
+        os << vec;
+        return os.str();
+    }
+
+    TEST_CASE("operator<< keeps its format for integers", "[text-format]") {
+        Vector<int> ints;
+        for (int v : {0, 1, -1, 42, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()}) {
+            ints.push_back(v);
+        }
+        CHECK(fast(ints) == stream_reference(ints));
+
+        Vector<unsigned long long> wide;
+        wide.push_back(std::numeric_limits<unsigned long long>::max());
+        CHECK(fast(wide) == stream_reference(wide));
+
+        Vector<short> shorts;
+        shorts.push_back(-7);
+        CHECK(fast(shorts) == "-7 ");
+    }
+
+    TEST_CASE("operator<< keeps its format for floating point", "[text-format]") {
+        Vector<double> doubles;
+        for (double v : {0.0, -0.0, 0.1, 1.0 / 3.0, 1e-5, 123456.0, 1234567.0, 1e300, -2.5e-300,
+                         std::numeric_limits<double>::infinity(), std::nan("")}) {
+            doubles.push_back(v);
+        }
+        CHECK(fast(doubles) == stream_reference(doubles));
+        CHECK(fast(doubles, nullptr, 17) == stream_reference(doubles, nullptr, 17));
+        CHECK(fast(doubles, nullptr, 0) == stream_reference(doubles, nullptr, 0));
+
+        Vector<float> floats;
+        for (float v : {0.1f, 3.14159265f, 1e20f}) floats.push_back(v);
+        CHECK(fast(floats) == stream_reference(floats));
+
+        Vector<long double> longs;
+        longs.push_back(1.0L / 7.0L);
+        CHECK(fast(longs) == stream_reference(longs));
+    }
+
+    TEST_CASE("operator<< falls back to the stream for manipulators", "[text-format]") {
+        Vector<int> ints;
+        for (int v : {10, 255}) ints.push_back(v);
+        CHECK(fast(ints, std::hex) == "a ff ");
+
+        Vector<double> doubles;
+        doubles.push_back(1.5);
+        CHECK(fast(doubles, std::fixed) == "1.500000 ");
+        CHECK(fast(doubles, std::scientific) == stream_reference(doubles, std::scientific));
+
+        std::ostringstream os;
+        os << std::setw(4) << ints;
+        CHECK(os.str() == "  10 255 ");
+    }
+
+    TEST_CASE("operator<< prints character types as characters", "[text-format]") {
+        Vector<char> chars;
+        chars.push_back('h');
+        chars.push_back('i');
+        CHECK(fast(chars) == "h i ");
+
+        Vector<int8_t> small;
+        small.push_back('A');
+        CHECK(fast(small) == "A ");
+    }
+
+    TEST_CASE("write_text takes separators and precision", "[text-format]") {
+        Vector<double> values;
+        for (double v : {0.1, 2.0, 1.0 / 3.0}) values.push_back(v);
+
+        std::ostringstream csv;
+        write_text(csv, values, TextFormat{",", false, -1});
+        CHECK(csv.str() == "0.1,2,0.3333333333333333");
+
+        std::ostringstream fixed;
+        write_text(fixed, values, TextFormat{"\n", true, 2, std::chars_format::fixed});
+        CHECK(fixed.str() == "0.10\n2.00\n0.33\n");
+
+        std::ostringstream empty;
+        write_text(empty, Vector<int>());
+        CHECK(empty.str().empty());
+    }
+
+    TEST_CASE("write_text spans many chunks", "[text-format]") {
+        Vector<long> values;
+        for (long i = 0; i < 100000; ++i) values.push_back(i * 1000003);
+        CHECK(fast(values) == stream_reference(values));
+    }
+}
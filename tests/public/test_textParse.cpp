@@ -0,0 +1,109 @@
+#include <ics_text_parse.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+namespace {
+    // Parses text through a pipe with a tiny chunk so tokens straddle reads.
+    template <typename T>
+    Vector<T> parse_through_pipe(const std::string& text, size_t chunk_size) {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        REQUIRE(::write(fds[1], text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+        ::close(fds[1]);
+        Vector<T> out;
+        try {
+            parse_fd_into(out, fds[0], chunk_size);
+        } catch (...) {
+            ::close(fds[0]);
+            throw;
+        }
+        ::close(fds[0]);
+        return out;
+    }
+
+    TEST_CASE("parse_into reads operator<< output back", "[text-parse]") {
+        Vector<int> ints;
+        for (int i = -500; i < 500; i += 7) ints.push_back(i * 1001);
+        std::ostringstream os;
+        os << ints;
+
+        Vector<int> parsed;
+        CHECK(parse_into(parsed, os.str()) == ints.size());
+        CHECK(parsed == ints);
+        CHECK(parsed.capacity() == parsed.size());
+    }
+
+    TEST_CASE("parse_into reads floating point text", "[text-parse]") {
+        Vector<double> values;
+        for (double v : {0.5, -1.25, 1e-300, 3.0, std::numeric_limits<double>::infinity()}) {
+            values.push_back(v);
+        }
+        std::ostringstream os;
+        write_text(os, values, TextFormat{" ", true, -1});
+
+        Vector<double> parsed;
+        parse_into(parsed, os.str());
+        CHECK(parsed == values);
+
+        Vector<double> nans;
+        parse_into(nans, "nan -nan");
+        REQUIRE(nans.size() == 2);
+        CHECK(std::isnan(nans[0]));
+        CHECK(std::isnan(nans[1]));
+    }
+
+    TEST_CASE("parse_into accepts CSV and mixed whitespace", "[text-parse]") {
+        Vector<long> parsed;
+        parse_into(parsed, "1,2,3\n4,5,6\r\n\t7  8,,9\n");
+        REQUIRE(parsed.size() == 9);
+        CHECK(parsed[0] == 1);
+        CHECK(parsed[8] == 9);
+
+        // appends to what is already there
+        parse_into(parsed, "10");
+        CHECK(parsed.size() == 10);
+        CHECK(parse_into(parsed, "   \n ") == 0);
+    }
+
+    TEST_CASE("parse_into counts tokens across SIMD blocks", "[text-parse]") {
+        std::string text;
+        for (int i = 0; i < 1000; ++i) {
+            text += std::to_string(i * 37);
+            text += std::string(static_cast<size_t>(1 + i % 19), i % 2 ? ' ' : ',');
+        }
+        CHECK(ics_detail::count_text_tokens(text) == 1000);
+        CHECK(ics_detail::count_text_tokens("x") == 1);
+        CHECK(ics_detail::count_text_tokens("") == 0);
+        CHECK(ics_detail::count_text_tokens("                 a") == 1);
+
+        Vector<int> parsed;
+        parse_into(parsed, text);
+        CHECK(parsed.size() == 1000);
+        CHECK(parsed[999] == 999 * 37);
+    }
+
+    TEST_CASE("parse_into rejects malformed numbers", "[text-parse]") {
+        Vector<int> parsed;
+        CHECK_THROWS_WITH(parse_into(parsed, "1 2x 3"), Catch::Matchers::ContainsSubstring("'2x'"));
+        CHECK_THROWS_AS(parse_into(parsed, "1.5"), VectorException);
+        CHECK_THROWS_AS(parse_into(parsed, "99999999999"), VectorException);
+    }
+
+    TEST_CASE("parse_fd_into streams in chunks", "[text-parse]") {
+        Vector<int> values;
+        for (int i = 0; i < 2000; ++i) values.push_back(i * 12345 % 99991 - 5000);
+        std::ostringstream os;
+        os << values;
+
+        CHECK(parse_through_pipe<int>(os.str(), 16) == values);
+        CHECK(parse_through_pipe<int>(os.str(), 1 << 20) == values);
+        CHECK(parse_through_pipe<int>("12 34", 16).size() == 2);
+        CHECK_THROWS_WITH(parse_through_pipe<int>("1234567890123456789", 8),
+                          Catch::Matchers::ContainsSubstring("longer than"));
+    }
+}
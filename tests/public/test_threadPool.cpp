@@ -0,0 +1,114 @@
+#include <ics_thread_pool.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    long fib(ThreadPool& pool, int n) {
+        if (n < 12) {
+            return n < 2 ? n : fib(pool, n - 1) + fib(pool, n - 2);
+        }
+        long a = 0;
+        long b = 0;
+        parallel_invoke(pool, [&] { a = fib(pool, n - 1); }, [&] { b = fib(pool, n - 2); });
+        return a + b;
+    }
+
+    // tasks fib() spawns: one per call above the cutoff
+    long spawned(int n) {
+        return n < 12 ? 0 : 1 + spawned(n - 1) + spawned(n - 2);
+    }
+
+    TEST_CASE("ChaseLevDeque: owner takes LIFO, thieves FIFO", "[thread-pool]") {
+        ics_detail::ChaseLevDeque<int> deque(2);
+        CHECK(deque.empty());
+        for (int i = 0; i < 10; ++i) deque.push(i);
+        int out = -1;
+        CHECK(deque.pop(out));
+        CHECK(out == 9);
+        CHECK(deque.steal(out));
+        CHECK(out == 0);
+
+        while (deque.pop(out)) {}
+
+        // each value leaves the deque exactly once under concurrent steals
+        constexpr int count = 200000;
+        std::atomic<int>* taken = new std::atomic<int>[count]();
+        std::atomic<bool> done{false};
+        Vector<std::thread> thieves;
+        for (int t = 0; t < 3; ++t) {
+            thieves.push_back(std::thread([&] {
+                int value;
+                while (!done.load() || !deque.empty()) {
+                    if (deque.steal(value) && value >= 0) taken[value].fetch_add(1);
+                }
+            }));
+        }
+        for (int i = 0; i < count; ++i) {
+            deque.push(i);
+            if (i % 3 == 0 && deque.pop(out)) taken[out].fetch_add(1);
+        }
+        while (deque.pop(out)) taken[out].fetch_add(1);
+        done.store(true);
+        for (std::thread& thief : thieves) thief.join();
+        bool once = true;
+        for (int i = 0; i < count; ++i) once = once && taken[i].load() == 1;
+        delete[] taken;
+        CHECK(once);
+    }
+
+    TEST_CASE("ThreadPool runs nested fork-join without deadlock", "[thread-pool]") {
+        ThreadPool pool(3);
+        CHECK(pool.size() == 3);
+        CHECK(pool.current_worker() == SIZE_MAX);
+        CHECK(fib(pool, 25) == 75025);
+
+        ThreadPoolStats stats = pool.stats();
+        CHECK(stats.executed == static_cast<uint64_t>(spawned(25)));
+
+        // a single worker must still make progress through nested waits
+        ThreadPool single(1);
+        CHECK(fib(single, 20) == 6765);
+    }
+
+    TEST_CASE("TaskGroup waits for its tasks and rethrows", "[thread-pool]") {
+        ThreadPool pool(2);
+        std::atomic<int> sum{0};
+        {
+            TaskGroup group(pool);
+            for (int i = 1; i <= 100; ++i) {
+                group.run([&sum, &group, i] {
+                    sum.fetch_add(i);
+                    if (i % 10 == 0) group.run([&sum] { sum.fetch_add(1000); });
+                });
+            }
+            group.wait();
+        }
+        CHECK(sum.load() == 5050 + 10000);
+
+        TaskGroup failing(pool);
+        failing.run([] { throw std::runtime_error("task failed"); });
+        failing.run([] {});
+        CHECK_THROWS_WITH(failing.wait(), "task failed");
+        failing.wait();
+
+        CHECK_THROWS_AS(parallel_invoke(pool, [] { throw std::logic_error("first"); }, [&sum] { sum.fetch_add(1); }),
+                        std::logic_error);
+    }
+
+    TEST_CASE("WorkerLocal gives every worker its own value", "[thread-pool]") {
+        ThreadPool pool(4);
+        WorkerLocal<long> partial(pool);
+        TaskGroup group(pool);
+        for (int i = 0; i < 1000; ++i) {
+            group.run([&partial, i] { partial.local() += i; });
+        }
+        partial.local() += 1;
+        group.wait();
+        long total = 0;
+        partial.for_each([&](long value) { total += value; });
+        CHECK(total == 499500 + 1);
+    }
+}
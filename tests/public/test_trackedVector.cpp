@@ -0,0 +1,190 @@
+#include <ics_tracked_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace {
+    std::string temp_path(const std::string& name) {
+        return (std::filesystem::temp_directory_path() / ("ics_tracked_vector_" + name)).string();
+    }
+
+    template <typename T>
+    size_t checkpoint_through(TrackedVector<T>& tracked, Vector<T>& replica, const std::string& path) {
+        {
+            ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_WRONLY | O_CREAT | O_TRUNC);
+            tracked.write_checkpoint(fd.get());
+        }
+        ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_RDONLY);
+        return apply_checkpoint(replica, fd.get());
+    }
+
+    Vector<int> iota(int n) {
+        Vector<int> values;
+        for (int i = 0; i < n; ++i) values.push_back(i);
+        return values;
+    }
+
+    TEST_CASE("TrackedVector marks the blocks it hands out for writing", "[tracked-vector]") {
+        TrackedVector<int> tracked(iota(1000), 100);
+        CHECK(tracked.block_size() == 128);
+        CHECK(tracked.dirty_count() == 8);
+        CHECK(TrackedVector<int>(Vector<int>(), size_t{1} << 31).block_size() == size_t{1} << 31);
+        CHECK_THROWS_AS(TrackedVector<int>(Vector<int>(), (size_t{1} << 31) + 1), VectorException);
+        CHECK_THROWS_AS(TrackedVector<int>(Vector<int>(), 0), VectorException);
+        tracked.clear_dirty();
+        CHECK(tracked.dirty_count() == 0);
+
+        const TrackedVector<int>& view = tracked;
+        CHECK(view[300] == 300);
+        CHECK(view.at(999) == 999);
+        int sum = 0;
+        for (int value : view) sum += value;
+        CHECK(sum == 999 * 1000 / 2);
+        CHECK(tracked.dirty_count() == 0);
+
+        tracked[0] = -1;
+        tracked.at(300) += 1;
+        *(tracked.begin() + 700) = 5;
+        CHECK(tracked.dirty_count() == 3);
+        CHECK(tracked.is_dirty(0));
+        CHECK(tracked.is_dirty(2));
+        CHECK(tracked.is_dirty(5));
+        CHECK_FALSE(tracked.is_dirty(1));
+        CHECK_THROWS_AS(tracked.at(1000), VectorException);
+
+        tracked.clear_dirty();
+        tracked.push_back(1000);
+        CHECK(tracked.dirty_count() == 1);
+        CHECK(tracked.is_dirty(7));
+
+        tracked.clear_dirty();
+        tracked.erase(tracked.begin() + 600, tracked.begin() + 610);
+        CHECK(tracked.size() == 991);
+        CHECK(tracked[600] == 610);
+        CHECK(tracked.is_dirty(4));
+        CHECK(tracked.is_dirty(7));
+        CHECK_FALSE(tracked.is_dirty(3));
+    }
+
+    TEST_CASE("Checkpoints replay changes onto a replica", "[tracked-vector]") {
+        std::string path = temp_path("replay.ckpt");
+        TrackedVector<int> tracked(iota(100000), 1024);
+        Vector<int> replica;
+
+        CHECK(checkpoint_through(tracked, replica, path) == 98);
+        CHECK(replica == tracked.values());
+
+        for (int i = 0; i < 10; ++i) tracked[static_cast<size_t>(i) * 5000] = -i;
+        size_t full = 100000 * sizeof(int);
+        CHECK(checkpoint_through(tracked, replica, path) == 10);
+        CHECK(std::filesystem::file_size(path) < full / 8);
+        CHECK(replica == tracked.values());
+
+        CHECK(checkpoint_through(tracked, replica, path) == 0);
+        CHECK(std::filesystem::file_size(path) == sizeof(CheckpointHeader));
+
+        for (int i = 0; i < 3000; ++i) tracked.push_back(i);
+        for (int i = 0; i < 50; ++i) tracked.pop_back();
+        CHECK(checkpoint_through(tracked, replica, path) == 4);
+        CHECK(replica == tracked.values());
+
+        tracked.erase(tracked.begin(), tracked.begin() + 90000);
+        checkpoint_through(tracked, replica, path);
+        CHECK(replica.size() == 12950);
+        CHECK(replica == tracked.values());
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("apply_checkpoint rejects bad checkpoints untouched", "[tracked-vector]") {
+        std::string path = temp_path("bad.ckpt");
+        TrackedVector<int> tracked(iota(5000), 1024);
+        Vector<int> replica;
+        checkpoint_through(tracked, replica, path);
+        Vector<int> before = replica;
+
+        tracked[4000] = 42;
+        {
+            ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_WRONLY | O_CREAT | O_TRUNC);
+            tracked.write_checkpoint(fd.get());
+        }
+        {
+            ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_RDWR);
+            unsigned char byte = 0xAB;
+            REQUIRE(::pwrite(fd.get(), &byte, 1, sizeof(CheckpointHeader) + sizeof(CheckpointBlock) + 3) == 1);
+        }
+        {
+            ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_RDONLY);
+            CHECK_THROWS_WITH(apply_checkpoint(replica, fd.get()), Catch::Matchers::ContainsSubstring("checksum"));
+        }
+        CHECK(replica == before);
+
+        {
+            ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_RDONLY);
+            Vector<float> wrong;
+            CHECK_THROWS_WITH(apply_checkpoint(wrong, fd.get()), Catch::Matchers::ContainsSubstring("type mismatch"));
+        }
+        // sizes the file cannot back are rejected before any allocation
+        auto patched_checkpoint = [&](uint64_t count, uint64_t blocks) {
+            {
+                ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_WRONLY | O_CREAT | O_TRUNC);
+                tracked.write_checkpoint(fd.get());
+            }
+            ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_RDWR);
+            REQUIRE(::pwrite(fd.get(), &count, sizeof(count), offsetof(CheckpointHeader, count)) == sizeof(count));
+            if (blocks != 0) {
+                REQUIRE(::pwrite(fd.get(), &blocks, sizeof(blocks), offsetof(CheckpointHeader, blocks)) == sizeof(blocks));
+            }
+            return ics_detail::open_file(path, O_RDONLY);
+        };
+        CHECK_THROWS_WITH(apply_checkpoint(replica, patched_checkpoint(uint64_t{1} << 40, 0).get()),
+                          Catch::Matchers::ContainsSubstring("past its blocks"));
+        CHECK_THROWS_WITH(apply_checkpoint(replica, patched_checkpoint(uint64_t{1} << 40, uint64_t{1} << 29).get()),
+                          Catch::Matchers::ContainsSubstring("end of file"));
+        CHECK(replica == before);
+
+        save_binary(before, path);
+        ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_RDONLY);
+        CHECK_THROWS_WITH(apply_checkpoint(replica, fd.get()), Catch::Matchers::ContainsSubstring("not a checkpoint"));
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("apply_checkpoint needs every block that grows the vector", "[tracked-vector]") {
+        std::string path = temp_path("grow.ckpt");
+        TrackedVector<int> tracked(iota(5000), 1024);
+        Vector<int> replica;
+        checkpoint_through(tracked, replica, path);
+        Vector<int> before = replica;
+
+        // blocks 0 and 4-7 are written; record k starts after k full blocks
+        tracked[0] = -1;
+        for (int i = 5000; i < 8192; ++i) tracked.push_back(i);
+        auto record_offset = [](uint64_t k) { return sizeof(CheckpointHeader) + k * (sizeof(CheckpointBlock) + 1024 * sizeof(int)); };
+        auto patched = [&](off_t offset, uint64_t value, bool truncate) {
+            for (size_t first : {0, 4096, 5120, 6144, 7168}) tracked[first] += 0;
+            {
+                ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_WRONLY | O_CREAT | O_TRUNC);
+                tracked.write_checkpoint(fd.get());
+            }
+            ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_RDWR);
+            REQUIRE(::pwrite(fd.get(), &value, sizeof(value), offset) == sizeof(value));
+            if (truncate) {
+                REQUIRE(::ftruncate(fd.get(), static_cast<off_t>(record_offset(4))) == 0);
+            }
+            return ics_detail::open_file(path, O_RDONLY);
+        };
+        // truncated: the last block is missing, though the blocks read hold
+        // more elements than the vector grows by
+        CHECK_THROWS_WITH(apply_checkpoint(replica, patched(offsetof(CheckpointHeader, blocks), 4, true).get()),
+                          Catch::Matchers::ContainsSubstring("past its blocks"));
+        // block 6 sent twice in place of block 7
+        CHECK_THROWS_WITH(apply_checkpoint(replica, patched(static_cast<off_t>(record_offset(4)), 6, false).get()),
+                          Catch::Matchers::ContainsSubstring("repeated"));
+        CHECK(replica == before);
+        tracked.mark_all_dirty();
+        checkpoint_through(tracked, replica, path);
+        CHECK(replica == tracked.values());
+        std::remove(path.c_str());
+    }
+}
@@ -0,0 +1,21 @@
+#include <ics_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <cstdint>
+
+namespace {
+    struct alignas(128) Wide {
+        int value;
+    };
+
+    TEST_CASE("Vector honours over-aligned element types", "[vector-alignment]") {
+        Vector<Wide> vec;
+        for (int i = 0; i < 100; ++i) {
+            vec.push_back(Wide{i});
+            CHECK(reinterpret_cast<std::uintptr_t>(&vec[0]) % alignof(Wide) == 0);
+        }
+        Vector<Wide> copy = vec;
+        CHECK(reinterpret_cast<std::uintptr_t>(&copy[0]) % alignof(Wide) == 0);
+        CHECK(copy[99].value == 99);
+    }
+}
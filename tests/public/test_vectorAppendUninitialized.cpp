@@ -0,0 +1,36 @@
+#include <ics_vector.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <string>
+
+namespace {
+    template <typename T>
+    concept CanAppendUninitialized = requires(Vector<T> vec) { vec.append_uninitialized(1); };
+
+    TEST_CASE("append_uninitialized grows size in place", "[append-uninitialized]") {
+        Vector<int> vec;
+        vec.push_back(1);
+
+        int* slots = vec.append_uninitialized(3);
+        slots[0] = 2;
+        slots[1] = 3;
+        slots[2] = 4;
+
+        CHECK(vec.size() == 4);
+        CHECK(vec.capacity() == 4);
+        CHECK(slots == vec.data() + 1);
+        CHECK(vec[3] == 4);
+    }
+
+    TEST_CASE("append_uninitialized allocates exactly into an empty vector", "[append-uninitialized]") {
+        Vector<double> vec;
+        vec.append_uninitialized(1000);
+        CHECK(vec.size() == 1000);
+        CHECK(vec.capacity() == 1000);
+    }
+
+    TEST_CASE("append_uninitialized is limited to trivially copyable types", "[append-uninitialized]") {
+        CHECK(CanAppendUninitialized<int>);
+        CHECK_FALSE(CanAppendUninitialized<std::string>);
+    }
+}
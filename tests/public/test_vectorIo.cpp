@@ -0,0 +1,169 @@
+#include <ics_vector_io.hpp>
+#include <catch_amalgamated.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace {
+    std::string temp_path(const std::string& name) {
+        return (std::filesystem::temp_directory_path() / ("ics_vector_io_" + name)).string();
+    }
+
+    struct Point {
+        int x;
+        float y;
+
+        bool operator==(const Point&) const = default;
+    };
+
+    TEST_CASE("Binary format round trips trivially copyable vectors", "[vector-io]") {
+        std::string path = temp_path("pod.bin");
+        Vector<int64_t> values;
+        for (int64_t i = 0; i < 100000; ++i) values.push_back(i * i);
+
+        save_binary(values, path);
+        CHECK(std::filesystem::file_size(path) == sizeof(BinaryHeader) + 100000 * sizeof(int64_t));
+        Vector<int64_t> loaded = load_binary<int64_t>(path);
+        CHECK(loaded == values);
+        CHECK(loaded.capacity() == loaded.size());
+
+        Vector<Point> points;
+        points.push_back(Point{1, 2.5f});
+        points.push_back(Point{-3, 0.0f});
+        save_binary(points, path);
+        CHECK((load_binary<Point>(path) == points));
+
+        save_binary(Vector<double>(), path);
+        CHECK(load_binary<double>(path).empty());
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("Binary format uses the serializer for other types", "[vector-io]") {
+        std::string path = temp_path("strings.bin");
+        Vector<std::string> words;
+        for (int i = 0; i < 5000; ++i) words.push_back(std::string(static_cast<size_t>(i % 40), 'a' + i % 26));
+
+        save_binary(words, path);
+        CHECK(load_binary<std::string>(path) == words);
+
+        Vector<Vector<int>> nested;
+        nested.push_back(Vector<int>());
+        nested.push_back(Vector<int>());
+        nested[1].push_back(4);
+        nested[1].push_back(2);
+        save_binary(nested, path);
+        Vector<Vector<int>> loaded = load_binary<Vector<int>>(path);
+        REQUIRE(loaded.size() == 2);
+        CHECK(loaded[0].empty());
+        CHECK(loaded[1] == nested[1]);
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("Binary format allows several vectors per stream", "[vector-io]") {
+        std::string path = temp_path("stream.bin");
+        Vector<std::string> first;
+        first.push_back("one");
+        Vector<int> second;
+        second.push_back(2);
+        {
+            ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_WRONLY | O_CREAT | O_TRUNC);
+            write_binary(fd.get(), first);
+            write_binary(fd.get(), second);
+        }
+        ics_detail::FileDescriptor fd = ics_detail::open_file(path, O_RDONLY);
+        CHECK(read_binary<std::string>(fd.get()) == first);
+        CHECK(read_binary<int>(fd.get()) == second);
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("Binary format validates the header", "[vector-io]") {
+        std::string path = temp_path("header.bin");
+        Vector<int32_t> values;
+        values.push_back(1);
+        save_binary(values, path);
+
+        CHECK_THROWS_WITH(load_binary<uint32_t>(path), Catch::Matchers::ContainsSubstring("type mismatch"));
+        CHECK_THROWS_WITH(load_binary<float>(path), Catch::Matchers::ContainsSubstring("type mismatch"));
+        CHECK_THROWS_WITH(load_binary<std::string>(path), Catch::Matchers::ContainsSubstring("type mismatch"));
+
+        std::filesystem::resize_file(path, sizeof(BinaryHeader) + 2);
+        CHECK_THROWS_WITH(load_binary<int32_t>(path), Catch::Matchers::ContainsSubstring("end of file"));
+
+        save_binary(Vector<char>(), path);
+        std::FILE* file = std::fopen(path.c_str(), "r+b");
+        std::fputc('X', file);
+        std::fclose(file);
+        CHECK_THROWS_WITH(load_binary<char>(path), Catch::Matchers::ContainsSubstring("not a binary vector"));
+        std::remove(path.c_str());
+    }
+
+    TEST_CASE("Binary type tags follow the element type", "[vector-io]") {
+        CHECK(vector_type_tag<int8_t>() == VectorTypeTag::int8);
+        CHECK(vector_type_tag<uint16_t>() == VectorTypeTag::uint16);
+        CHECK(vector_type_tag<int32_t>() == VectorTypeTag::int32);
+        CHECK(vector_type_tag<uint64_t>() == VectorTypeTag::uint64);
+        CHECK(vector_type_tag<double>() == VectorTypeTag::float64);
+        CHECK(vector_type_tag<bool>() == VectorTypeTag::boolean);
+        CHECK(vector_type_tag<Point>() == VectorTypeTag::raw);
+        CHECK(vector_type_tag<std::string>() == VectorTypeTag::custom);
+    }
+
+    void patch_u64(const std::string& path, long offset, uint64_t value) {
+        std::FILE* file = std::fopen(path.c_str(), "r+b");
+        std::fseek(file, offset, SEEK_SET);
+        std::fwrite(&value, sizeof(value), 1, file);
+        std::fclose(file);
+    }
+
+    TEST_CASE("Binary format rejects counts the file cannot hold", "[vector-io]") {
+        std::string path = temp_path("counts.bin");
+        Vector<int64_t> numbers;
+        numbers.push_back(1);
+        save_binary(numbers, path);
+        patch_u64(path, offsetof(BinaryHeader, count), uint64_t{1} << 40);
+        CHECK_THROWS_WITH(load_binary<int64_t>(path), Catch::Matchers::ContainsSubstring("end of file"));
+        patch_u64(path, offsetof(BinaryHeader, count), UINT64_MAX / 4);
+        CHECK_THROWS_WITH(load_binary<int64_t>(path), Catch::Matchers::ContainsSubstring("too large"));
+
+        Vector<std::string> words;
+        words.push_back("abc");
+        save_binary(words, path);
+        patch_u64(path, sizeof(BinaryHeader), uint64_t{1} << 50);
+        CHECK_THROWS_WITH(load_binary<std::string>(path), Catch::Matchers::ContainsSubstring("end of file"));
+        save_binary(words, path);
+        patch_u64(path, offsetof(BinaryHeader, count), uint64_t{1} << 60);
+        CHECK_THROWS_WITH(load_binary<std::string>(path), Catch::Matchers::ContainsSubstring("end of file"));
+
+        Vector<Vector<int>> nested;
+        nested.push_back(Vector<int>());
+        save_binary(nested, path);
+        patch_u64(path, sizeof(BinaryHeader), uint64_t{1} << 62);
+        CHECK_THROWS_WITH(load_binary<Vector<int>>(path), Catch::Matchers::ContainsSubstring("end of file"));
+        std::remove(path.c_str());
+    }
+
+    template <typename T>
+    Vector<T> through_pipe(const Vector<T>& values) {
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        ics_detail::FileDescriptor reader(fds[0]);
+        {
+            ics_detail::FileDescriptor writer(fds[1]);
+            write_binary(writer.get(), values);
+        }
+        return read_binary<T>(reader.get());
+    }
+
+    TEST_CASE("Binary format reads from pipes", "[vector-io]") {
+        Vector<std::string> words;
+        words.push_back("pipe");
+        words.push_back(std::string(3000, 'x'));
+        CHECK(through_pipe(words) == words);
+        Vector<int> numbers;
+        for (int i = 0; i < 1000; ++i) numbers.push_back(i);
+        CHECK(through_pipe(numbers) == numbers);
+    }
+}